@@ -0,0 +1,411 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "dependency_graph.hpp"
+#include "exact_solver.hpp"
+#include "lower_bound.hpp"
+#include "solver.hpp"
+#include "thread_pool.hpp"
+
+struct BenchOptions {
+    std::string target;
+    int seeds = 5;
+    int jobs = std::max(1u, std::thread::hardware_concurrency());
+    Solver::Options solver_options;
+    std::filesystem::path csv_path;
+    std::filesystem::path json_path;
+    std::filesystem::path baseline_path;
+    double tolerance = 1.0;  // percent
+
+    // instances with at most this many jobs are solved exactly, once, with the heuristic as first bound
+    int exact_threshold = 25;
+};
+
+struct InstanceReport {
+    std::string instance;
+    int job_count = 0;
+    int runs = 0;
+    int valid_runs = 0;
+    int best_timespan = std::numeric_limits<int>::max();
+    int worst_timespan = 0;
+    double mean_timespan = 0;
+    double wall_time_ms = 0;
+    double construction_time_ms = 0;
+    double local_search_time_ms = 0;
+    long long moves_evaluated = 0;
+    int lower_bound = 0;
+    bool optimal = false;
+
+    // what the instance threw, a failed instance is left out of the CSV and JSON reports
+    std::string error;
+};
+
+void printUsage(const char *program_name) {
+    std::cout << "Usage: " << program_name << " <instance directory or glob> [--seeds N] [--jobs N] [--iterations N] [--seed N] [--alpha X|reactive]\n"
+              << "       [--perturbations N] [--elite N] [--tabu N] [--granular K] [--time-limit ms] [--exact-threshold N] [--csv file] [--json file] [--baseline file.csv]\n"
+              << "       [--tolerance percent] [--store directory]\n";
+}
+
+// '*' matches any run of characters and '?' a single one
+bool matchesPattern(std::string_view name, std::string_view pattern) {
+    if (pattern.empty()) {
+        return name.empty();
+    }
+
+    if (pattern.front() == '*') {
+        for (int i = 0; i <= name.size(); i++) {
+            if (matchesPattern(name.substr(i), pattern.substr(1))) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    if (name.empty() || (pattern.front() != '?' && pattern.front() != name.front())) {
+        return false;
+    }
+
+    return matchesPattern(name.substr(1), pattern.substr(1));
+}
+
+std::vector<std::filesystem::path> collectInstances(const std::string& target) {
+    std::filesystem::path directory{target};
+    std::string pattern = "*.txt";
+
+    if (!std::filesystem::is_directory(directory)) {
+        pattern = directory.filename().string();
+        directory = directory.has_parent_path() ? directory.parent_path() : std::filesystem::path{"."};
+    }
+
+    std::vector<std::filesystem::path> instance_file_paths;
+    for (const auto& entry : std::filesystem::directory_iterator{directory}) {
+        // binary sidecars written by DependencyGraph::load sit next to the instances and would be run twice
+        if (entry.is_regular_file() && entry.path().extension() != ".bin" && matchesPattern(entry.path().filename().string(), pattern)) {
+            instance_file_paths.push_back(entry.path());
+        }
+    }
+    std::sort(instance_file_paths.begin(), instance_file_paths.end());
+
+    return instance_file_paths;
+}
+
+double toMilliseconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+InstanceReport runInstance(const std::filesystem::path& instance_file_path, const BenchOptions& options) {
+    InstanceReport report;
+    report.instance = instance_file_path.filename().string();
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    auto dependency_graph = DependencyGraph::load(instance_file_path);
+    report.job_count = dependency_graph.getJobCount();
+
+    // instances already run in parallel, so each run stays on its own thread
+    auto solver_options = options.solver_options;
+    solver_options.threads = 1;
+
+    bool exact = report.job_count <= options.exact_threshold;
+    int runs = exact ? 1 : options.seeds;
+
+    long long timespan_sum = 0;
+    for (int seed = 0; seed < runs; seed++) {
+        solver_options.seed = options.solver_options.seed + seed;
+        auto result = Solver::multiStart(dependency_graph, solver_options);
+
+        if (exact) {
+            ExactSolver::Options exact_options;
+            exact_options.time_limit = solver_options.time_limit;
+
+            auto exact_result = ExactSolver::solve(dependency_graph, exact_options, result.schedule);
+            report.optimal = exact_result.optimal;
+            if (exact_result.valid) {
+                result.timespan = exact_result.timespan;
+                result.valid = true;
+            }
+        }
+
+        report.runs++;
+        report.valid_runs += result.valid;
+        report.best_timespan = std::min(report.best_timespan, result.timespan);
+        report.worst_timespan = std::max(report.worst_timespan, result.timespan);
+        timespan_sum += result.timespan;
+        report.construction_time_ms += toMilliseconds(result.construction_time);
+        report.local_search_time_ms += toMilliseconds(result.local_search_time);
+        report.moves_evaluated += result.moves_evaluated;
+        report.lower_bound = result.lower_bound;
+        report.optimal = report.optimal || (result.valid && result.timespan <= result.lower_bound);
+    }
+
+    report.mean_timespan = static_cast<double>(timespan_sum) / report.runs;
+    report.wall_time_ms = toMilliseconds(std::chrono::steady_clock::now() - start_time);
+
+    return report;
+}
+
+constexpr const char *csv_header = "instance,jobs,runs,valid_runs,best,mean,worst,wall_ms,construction_ms,local_search_ms,moves_evaluated";
+
+void writeCsv(const std::filesystem::path& output_file_path, const std::vector<InstanceReport>& reports) {
+    std::ofstream file_writer{output_file_path};
+    file_writer << std::fixed << std::setprecision(3);
+
+    file_writer << csv_header << "\n";
+    for (const auto& report : reports) {
+        if (!report.error.empty()) {
+            continue;
+        }
+
+        file_writer << report.instance << "," << report.job_count << "," << report.runs << "," << report.valid_runs << ","
+                    << report.best_timespan << "," << report.mean_timespan << "," << report.worst_timespan << ","
+                    << report.wall_time_ms << "," << report.construction_time_ms << "," << report.local_search_time_ms << ","
+                    << report.moves_evaluated << "\n";
+    }
+}
+
+void writeJson(const std::filesystem::path& output_file_path, const std::vector<InstanceReport>& reports) {
+    std::ofstream file_writer{output_file_path};
+    file_writer << std::fixed << std::setprecision(3);
+
+    bool first = true;
+    file_writer << "[\n";
+    for (const auto& report : reports) {
+        if (!report.error.empty()) {
+            continue;
+        }
+
+        file_writer << (first ? "" : ",\n") << "  {\"instance\": \"" << report.instance << "\", \"jobs\": " << report.job_count
+                    << ", \"runs\": " << report.runs << ", \"valid_runs\": " << report.valid_runs
+                    << ", \"best\": " << report.best_timespan << ", \"mean\": " << report.mean_timespan
+                    << ", \"worst\": " << report.worst_timespan << ", \"wall_ms\": " << report.wall_time_ms
+                    << ", \"construction_ms\": " << report.construction_time_ms
+                    << ", \"local_search_ms\": " << report.local_search_time_ms
+                    << ", \"moves_evaluated\": " << report.moves_evaluated
+                    << ", \"lower_bound\": " << report.lower_bound
+                    << ", \"gap\": " << LowerBound::gap(report.best_timespan, report.lower_bound)
+                    << ", \"optimal\": " << (report.optimal ? "true" : "false") << "}";
+        first = false;
+    }
+    file_writer << (first ? "" : "\n") << "]\n";
+}
+
+std::map<std::string, InstanceReport> readCsv(const std::filesystem::path& input_file_path) {
+    std::ifstream file_reader{input_file_path};
+    if (!file_reader) {
+        throw std::invalid_argument{"Couldn't open baseline " + input_file_path.string() + ".\n"};
+    }
+
+    std::string current_line;
+    std::getline(file_reader, current_line);
+    if (current_line != csv_header) {
+        throw std::invalid_argument{"Baseline " + input_file_path.string() + " isn't a bench report.\n"};
+    }
+
+    std::map<std::string, InstanceReport> reports;
+    while (std::getline(file_reader, current_line)) {
+        std::stringstream line_stream{current_line};
+        std::vector<std::string> fields;
+        for (std::string field; std::getline(line_stream, field, ',');) {
+            fields.push_back(field);
+        }
+
+        if (fields.size() != 11) {
+            throw std::invalid_argument{"Malformed baseline line: " + current_line + "\n"};
+        }
+
+        InstanceReport report;
+        report.instance = fields[0];
+        report.job_count = std::stoi(fields[1]);
+        report.runs = std::stoi(fields[2]);
+        report.valid_runs = std::stoi(fields[3]);
+        report.best_timespan = std::stoi(fields[4]);
+        report.mean_timespan = std::stod(fields[5]);
+        report.worst_timespan = std::stoi(fields[6]);
+        report.wall_time_ms = std::stod(fields[7]);
+        report.construction_time_ms = std::stod(fields[8]);
+        report.local_search_time_ms = std::stod(fields[9]);
+        report.moves_evaluated = std::stoll(fields[10]);
+
+        reports.emplace(report.instance, report);
+    }
+
+    return reports;
+}
+
+double percentChange(double before, double after) {
+    return before == 0 ? 0 : (after - before) / before * 100;
+}
+
+// A change is rejected when any instance fails, loses valid runs or gets a worse mean timespan beyond
+// the tolerance, or when the total wall time grows beyond it; per-instance wall times are too noisy to judge alone.
+bool compareWithBaseline(const std::vector<InstanceReport>& reports, const std::map<std::string, InstanceReport>& baseline, double tolerance) {
+    bool accepted = true;
+    double baseline_wall_time_ms = 0;
+    double wall_time_ms = 0;
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& report : reports) {
+        if (!report.error.empty()) {
+            std::cout << report.instance << ": failed  REGRESSED\n";
+            accepted = false;
+            continue;
+        }
+
+        auto baseline_report = baseline.find(report.instance);
+        if (baseline_report == baseline.end()) {
+            std::cout << report.instance << ": not in baseline\n";
+            continue;
+        }
+
+        const auto& before = baseline_report->second;
+        double mean_change = percentChange(before.mean_timespan, report.mean_timespan);
+        bool regressed = report.valid_runs < before.valid_runs || mean_change > tolerance;
+
+        std::cout << report.instance << ": best " << before.best_timespan << " -> " << report.best_timespan
+                  << ", mean " << before.mean_timespan << " -> " << report.mean_timespan << " (" << mean_change << "%)"
+                  << ", wall " << before.wall_time_ms << "ms -> " << report.wall_time_ms << "ms"
+                  << (regressed ? "  REGRESSED" : "") << "\n";
+
+        accepted = accepted && !regressed;
+        baseline_wall_time_ms += before.wall_time_ms;
+        wall_time_ms += report.wall_time_ms;
+    }
+
+    double wall_time_change = percentChange(baseline_wall_time_ms, wall_time_ms);
+    std::cout << "total wall time " << baseline_wall_time_ms << "ms -> " << wall_time_ms << "ms (" << wall_time_change << "%)\n";
+    accepted = accepted && wall_time_change <= tolerance;
+
+    std::cout << (accepted ? "ACCEPTED" : "REJECTED") << "\n";
+
+    return accepted;
+}
+
+BenchOptions parseOptions(int argc, char *argv[]) {
+    if (argc < 2) {
+        throw std::invalid_argument{"Missing instance directory or glob.\n"};
+    }
+
+    BenchOptions options;
+    options.target = argv[1];
+
+    // a time limit doesn't lift the iteration count here, so every run does the same work
+    bool iterations_given = false;
+
+    for (int i = 2; i < argc; i++) {
+        std::string option{argv[i]};
+
+        if (i + 1 == argc) {
+            throw std::invalid_argument{"Missing value for " + option + ".\n"};
+        }
+        std::string value{argv[++i]};
+
+        // the bench's own options, the rest go through the parser the CLI and the solve service use
+        // (runInstance keeps every run on one thread whatever --threads says)
+        if (option == "--seeds") {
+            options.seeds = std::stoi(value);
+            if (options.seeds < 1) {
+                throw std::invalid_argument{"--seeds takes at least 1.\n"};
+            }
+        } else if (option == "--jobs") {
+            options.jobs = std::stoi(value);
+            if (options.jobs < 1) {
+                throw std::invalid_argument{"--jobs takes at least 1.\n"};
+            }
+        } else if (option == "--exact-threshold") {
+            options.exact_threshold = std::stoi(value);
+            if (options.exact_threshold > ExactSolver::max_job_count) {
+                throw std::invalid_argument{"--exact-threshold takes at most " + std::to_string(ExactSolver::max_job_count) + ".\n"};
+            }
+        } else if (option == "--csv") {
+            options.csv_path = value;
+        } else if (option == "--json") {
+            options.json_path = value;
+        } else if (option == "--baseline") {
+            options.baseline_path = value;
+        } else if (option == "--tolerance") {
+            options.tolerance = std::stod(value);
+        } else if (!Solver::parseOption(options.solver_options, option, value, iterations_given)) {
+            throw std::invalid_argument{"Unknown option " + option + ".\n"};
+        }
+    }
+
+    return options;
+}
+
+int main(int argc, char *argv[]) {
+    BenchOptions options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const std::exception& exception) {
+        std::cout << exception.what();
+        printUsage(argv[0]);
+
+        return 1;
+    }
+
+    auto instance_file_paths = collectInstances(options.target);
+    if (instance_file_paths.empty()) {
+        std::cout << "No instances match " << options.target << ".\n";
+
+        return 1;
+    }
+
+    std::vector<InstanceReport> reports(instance_file_paths.size());
+    {
+        ThreadPool thread_pool{options.jobs};
+        for (int i = 0; i < instance_file_paths.size(); i++) {
+            // an exception escaping a pool task would end the whole sweep, one bad instance only fails itself
+            thread_pool.submit([&, i]() {
+                try {
+                    reports[i] = runInstance(instance_file_paths[i], options);
+                } catch (const std::exception& exception) {
+                    reports[i].instance = instance_file_paths[i].filename().string();
+                    reports[i].error = exception.what();
+                }
+            });
+        }
+        thread_pool.wait();
+    }
+
+    bool failed = false;
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& report : reports) {
+        if (!report.error.empty()) {
+            std::cout << report.instance << ": failed, " << report.error;
+            failed = true;
+            continue;
+        }
+
+        std::cout << report.instance << ": best " << report.best_timespan << ", mean " << report.mean_timespan
+                  << ", worst " << report.worst_timespan << ", gap " << LowerBound::gap(report.best_timespan, report.lower_bound) << "%, valid " << report.valid_runs << "/" << report.runs
+                  << ", " << report.wall_time_ms << "ms" << (report.optimal ? " (optimal)" : "") << "\n";
+    }
+
+    if (!options.csv_path.empty()) {
+        writeCsv(options.csv_path, reports);
+    }
+
+    if (!options.json_path.empty()) {
+        writeJson(options.json_path, reports);
+    }
+
+    if (!options.baseline_path.empty()) {
+        return compareWithBaseline(reports, readCsv(options.baseline_path), options.tolerance) ? 0 : 2;
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "dependency_graph.hpp"
+
+// the recursive walk the construction used before the table existed, kept here as the reference
+int recursiveCascadedDependentsDelay(int id, const DependencyGraph& dependency_graph) {
+    int cost = 0;
+    auto dependents = dependency_graph.getDependents(id);
+    auto delays = dependency_graph.getDependentDelays(id);
+
+    for (int k = 0; k < dependents.size(); k++) {
+        cost += delays[k];
+        cost += recursiveCascadedDependentsDelay(dependents[k], dependency_graph);
+    }
+
+    return cost;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 3) {
+        std::cout << "Usage: " << argv[0] << " [instance directory] [repetitions]\n";
+
+        return 1;
+    }
+
+    std::filesystem::path instance_directory{argc > 1 ? argv[1] : "selected_instances"};
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 1000;
+
+    std::vector<std::filesystem::path> instance_file_paths;
+    for (const auto& entry : std::filesystem::directory_iterator{instance_directory}) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            instance_file_paths.push_back(entry.path());
+        }
+    }
+    std::sort(instance_file_paths.begin(), instance_file_paths.end());
+
+    std::chrono::nanoseconds total_table_time{0};
+    std::chrono::nanoseconds total_recursive_time{0};
+
+    for (const auto& instance_file_path : instance_file_paths) {
+        DependencyGraph dependency_graph{instance_file_path};
+        int job_count = dependency_graph.getJobCount();
+
+        // one score per job and repetition, the same lookups the candidate scoring does
+        auto start_time = std::chrono::high_resolution_clock::now();
+        long long table_checksum = 0;
+        for (int repetition = 0; repetition < repetitions; repetition++) {
+            for (auto delay : dependency_graph.getCascadedDependentsDelay()) {
+                table_checksum += delay;
+            }
+        }
+        auto table_time = std::chrono::high_resolution_clock::now() - start_time;
+
+        start_time = std::chrono::high_resolution_clock::now();
+        long long recursive_checksum = 0;
+        for (int repetition = 0; repetition < repetitions; repetition++) {
+            for (int id = 1; id <= job_count; id++) {
+                recursive_checksum += recursiveCascadedDependentsDelay(id, dependency_graph);
+            }
+        }
+        auto recursive_time = std::chrono::high_resolution_clock::now() - start_time;
+
+        if (table_checksum != recursive_checksum) {
+            std::cout << "Mismatch on " << instance_file_path.filename() << "\n";
+
+            return 1;
+        }
+
+        total_table_time += table_time;
+        total_recursive_time += recursive_time;
+
+        std::cout << instance_file_path.filename().string() << ": "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(table_time).count() << "us table, "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(recursive_time).count() << "us recursive\n";
+    }
+
+    std::cout << "total: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(total_table_time).count() << "us table, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(total_recursive_time).count() << "us recursive\n";
+
+    return 0;
+}
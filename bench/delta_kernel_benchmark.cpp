@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "delta_kernels.hpp"
+#include "dependency_graph.hpp"
+#include "greedy.hpp"
+#include "move_evaluator.hpp"
+
+// every swap, insert, block (length 2 and 3) and reversal delta of one schedule, row by row, with
+// the scalar per-move methods when batch is false; returns the sum of the deltas
+long long scanNeighborhoods(const MoveEvaluator& move_evaluator, int job_count, bool batch, std::vector<int>& deltas) {
+    long long checksum = 0;
+
+    for (int i = 0; i < job_count; i++) {
+        if (batch) {
+            move_evaluator.swapTimespanDeltas(i, deltas);
+        } else {
+            for (int j = i + 1; j < job_count; j++) {
+                deltas[j] = move_evaluator.swapTimespanDelta(i, j);
+            }
+        }
+        for (int j = i + 1; j < job_count; j++) {
+            checksum += deltas[j] * (j + 1);
+        }
+
+        if (batch) {
+            move_evaluator.insertTimespanDeltas(i, deltas);
+        } else {
+            for (int j = 0; j < job_count; j++) {
+                deltas[j] = move_evaluator.insertTimespanDelta(i, j);
+            }
+        }
+        for (int j = 0; j < job_count; j++) {
+            checksum += deltas[j] * (j + 1);
+        }
+
+        for (int length = 2; length <= 3 && i + length <= job_count; length++) {
+            if (batch) {
+                move_evaluator.blockTimespanDeltas(i, length, deltas);
+            } else {
+                for (int j = 0; j + length <= job_count; j++) {
+                    deltas[j] = move_evaluator.blockTimespanDelta(i, length, j);
+                }
+            }
+            for (int j = 0; j + length <= job_count; j++) {
+                checksum += deltas[j] * (j + 1);
+            }
+        }
+
+        if (batch) {
+            move_evaluator.reverseTimespanDeltas(i, deltas);
+        } else {
+            for (int j = i + 1; j < job_count; j++) {
+                deltas[j] = move_evaluator.reverseTimespanDelta(i, j);
+            }
+        }
+        for (int j = i + 1; j < job_count; j++) {
+            checksum += deltas[j] * (j + 1);
+        }
+    }
+
+    return checksum;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 3) {
+        std::cout << "Usage: " << argv[0] << " [instance directory] [repetitions]\n";
+
+        return 1;
+    }
+
+    std::filesystem::path instance_directory{argc > 1 ? argv[1] : "selected_instances"};
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 20;
+
+    std::vector<std::filesystem::path> instance_file_paths;
+    for (const auto& entry : std::filesystem::directory_iterator{instance_directory}) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            instance_file_paths.push_back(entry.path());
+        }
+    }
+    std::sort(instance_file_paths.begin(), instance_file_paths.end());
+
+    if (instance_file_paths.empty()) {
+        std::cout << "No instances in " << instance_directory << ".\n";
+
+        return 1;
+    }
+
+    std::vector<DependencyGraph> dependency_graphs;
+    std::vector<MoveEvaluator> move_evaluators;
+    dependency_graphs.reserve(instance_file_paths.size());
+    for (const auto& instance_file_path : instance_file_paths) {
+        dependency_graphs.push_back(DependencyGraph::load(instance_file_path));
+        move_evaluators.emplace_back(dependency_graphs.back());
+        move_evaluators.back().load(Greedy::greedyRandomizedAdaptiveProcedure(dependency_graphs.back(), 0.3, 1));
+    }
+
+    auto dispatched = DeltaKernels::active();
+    std::cout << "dispatch picks " << DeltaKernels::name(dispatched) << "\n";
+
+    // the scalar per-move methods first, then the batch rows on every instruction set this CPU has
+    std::vector<DeltaKernels::InstructionSet> instruction_sets{DeltaKernels::InstructionSet::scalar};
+    for (auto instruction_set : {DeltaKernels::InstructionSet::avx2, DeltaKernels::InstructionSet::avx512}) {
+        if (instruction_set <= DeltaKernels::detect()) {
+            instruction_sets.push_back(instruction_set);
+        }
+    }
+
+    long long expected_checksum = 0;
+    double per_move_seconds = 0;
+    for (int run = -1; run < static_cast<int>(instruction_sets.size()); run++) {
+        bool batch = run >= 0;
+        if (batch) {
+            DeltaKernels::use(instruction_sets[run]);
+        }
+
+        long long checksum = 0;
+        long long moves = 0;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        for (int repetition = 0; repetition < repetitions; repetition++) {
+            for (int k = 0; k < move_evaluators.size(); k++) {
+                int job_count = dependency_graphs[k].getJobCount();
+                std::vector<int> deltas(job_count);
+
+                checksum += scanNeighborhoods(move_evaluators[k], job_count, batch, deltas);
+                // about n^2 / 2 swaps and reversals, n^2 inserts and 2 n^2 block moves
+                moves += 4LL * job_count * job_count;
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+        if (!batch) {
+            expected_checksum = checksum;
+            per_move_seconds = seconds;
+        } else if (checksum != expected_checksum) {
+            std::cout << "Batch deltas with " << DeltaKernels::name(instruction_sets[run]) << " differ from the per-move ones\n";
+
+            return 1;
+        }
+
+        std::cout << (batch ? std::string{"batch "} + DeltaKernels::name(instruction_sets[run]) : std::string{"per move"}) << ": "
+                  << seconds * 1000 << "ms, " << moves / seconds / 1e6 << "M moves/s, "
+                  << per_move_seconds / seconds << "x\n";
+    }
+
+    DeltaKernels::use(dispatched);
+
+    return 0;
+}
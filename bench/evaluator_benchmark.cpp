@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dependency_graph.hpp"
+#include "greedy.hpp"
+#include "local_search.hpp"
+#include "move_evaluator.hpp"
+#include "schedule_evaluator.hpp"
+#include "sized_kernels.hpp"
+#include "stats.hpp"
+
+int main(int argc, char *argv[]) {
+    if (argc > 3) {
+        std::cout << "Usage: " << argv[0] << " [instance directory] [schedules per instance]\n";
+
+        return 1;
+    }
+
+    std::filesystem::path instance_directory{argc > 1 ? argv[1] : "selected_instances"};
+    int schedule_count = argc > 2 ? std::stoi(argv[2]) : 200;
+
+    std::vector<std::filesystem::path> instance_file_paths;
+    for (const auto& entry : std::filesystem::directory_iterator{instance_directory}) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            instance_file_paths.push_back(entry.path());
+        }
+    }
+    std::sort(instance_file_paths.begin(), instance_file_paths.end());
+
+    std::chrono::nanoseconds total_greedy_time{0};
+    std::chrono::nanoseconds total_evaluator_time{0};
+    std::chrono::nanoseconds total_sized_evaluator_time{0};
+    std::chrono::nanoseconds total_greedy_construction_time{0};
+    std::chrono::nanoseconds total_sized_construction_time{0};
+    long long local_searches = 0;
+    long long local_search_allocations = 0;
+
+    for (const auto& instance_file_path : instance_file_paths) {
+        auto dependency_graph = DependencyGraph::load(instance_file_path);
+
+        auto kernels = SizedKernels::make(dependency_graph);
+
+        // the same constructions on both paths, which have to agree job for job
+        std::vector<unsigned int> seeds(schedule_count);
+        std::iota(seeds.begin(), seeds.end(), 1);
+
+        std::vector<std::vector<int>> schedules;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        for (unsigned int seed : seeds) {
+            schedules.push_back(Greedy::greedyRandomizedAdaptiveProcedure(dependency_graph, 0.3, seed));
+        }
+        auto greedy_construction_time = std::chrono::high_resolution_clock::now() - start_time;
+
+        start_time = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < schedule_count; i++) {
+            if (kernels->construct(0.3, seeds[i]) != schedules[i]) {
+                std::cout << "Construction mismatch on " << instance_file_path.filename() << "\n";
+
+                return 1;
+            }
+        }
+        auto sized_construction_time = std::chrono::high_resolution_clock::now() - start_time;
+
+        // some shuffled so that plenty of them are invalid
+        std::mt19937 generator{1};
+        for (int i = 1; i < schedule_count; i += 2) {
+            std::shuffle(schedules[i].begin(), schedules[i].end(), generator);
+        }
+
+        // keeps the evaluations from being optimized away, and every loop has to agree
+        long long checksum = 0;
+
+        start_time = std::chrono::high_resolution_clock::now();
+        for (const auto& schedule : schedules) {
+            checksum += Greedy::calculateTimespan(dependency_graph, schedule) * 2 + Greedy::checkScheduleValidity(dependency_graph, schedule);
+        }
+        auto greedy_time = std::chrono::high_resolution_clock::now() - start_time;
+
+        ScheduleEvaluator schedule_evaluator{dependency_graph};
+        start_time = std::chrono::high_resolution_clock::now();
+        for (const auto& schedule : schedules) {
+            auto evaluation = schedule_evaluator.evaluate(schedule);
+            checksum -= evaluation.timespan * 2 + evaluation.valid;
+        }
+        auto evaluator_time = std::chrono::high_resolution_clock::now() - start_time;
+
+        start_time = std::chrono::high_resolution_clock::now();
+        for (const auto& schedule : schedules) {
+            auto evaluation = kernels->evaluate(schedule);
+            checksum += evaluation.timespan * 2 + evaluation.valid;
+        }
+        auto sized_evaluator_time = std::chrono::high_resolution_clock::now() - start_time;
+
+        for (const auto& schedule : schedules) {
+            checksum -= Greedy::calculateTimespan(dependency_graph, schedule) * 2 + Greedy::checkScheduleValidity(dependency_graph, schedule);
+        }
+
+        if (checksum != 0) {
+            std::cout << "Mismatch on " << instance_file_path.filename() << "\n";
+
+            return 1;
+        }
+
+        // the workspace the solver keeps per worker, warmed up by one search before counting
+        MoveEvaluator move_evaluator{dependency_graph};
+        auto neighborhoods = LocalSearch::defaultNeighborhoods();
+        long long moves_evaluated = 0;
+        move_evaluator.load(schedules[0]);
+        LocalSearch::descend(move_evaluator, neighborhoods, moves_evaluated);
+
+        long long allocations_before = Stats::collect().counters[Stats::allocations];
+        for (int i = 1; i < std::min(schedule_count, 20); i++) {
+            move_evaluator.load(schedules[i]);
+            LocalSearch::descend(move_evaluator, neighborhoods, moves_evaluated);
+            schedule_evaluator.evaluate(move_evaluator.getSchedule());
+            local_searches++;
+        }
+        long long allocations = Stats::collect().counters[Stats::allocations] - allocations_before;
+        local_search_allocations += allocations;
+
+        total_greedy_time += greedy_time;
+        total_evaluator_time += evaluator_time;
+        total_sized_evaluator_time += sized_evaluator_time;
+        total_greedy_construction_time += greedy_construction_time;
+        total_sized_construction_time += sized_construction_time;
+
+        std::cout << instance_file_path.filename().string() << " (SizedKernels up to " << kernels->getMaxJobCount() << " jobs): evaluation "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(greedy_time).count() << "us Greedy, "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(evaluator_time).count() << "us ScheduleEvaluator, "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(sized_evaluator_time).count() << "us SizedKernels; construction "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(greedy_construction_time).count() << "us Greedy, "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(sized_construction_time).count() << "us SizedKernels; "
+                  << allocations << " allocations in local search\n";
+    }
+
+    std::cout << "total: evaluation " << std::chrono::duration_cast<std::chrono::microseconds>(total_greedy_time).count() << "us Greedy, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(total_evaluator_time).count() << "us ScheduleEvaluator, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(total_sized_evaluator_time).count() << "us SizedKernels; construction "
+              << std::chrono::duration_cast<std::chrono::microseconds>(total_greedy_construction_time).count() << "us Greedy, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(total_sized_construction_time).count() << "us SizedKernels\n";
+
+    if (!Stats::enabled) {
+        std::cout << "built without SCHEDULING_STATS, allocations weren't counted\n";
+
+        return 0;
+    }
+
+    std::cout << local_search_allocations << " allocations over " << local_searches << " warm local searches\n";
+
+    // the steady-state search loop is meant to stay off the heap entirely
+    return local_search_allocations == 0 ? 0 : 1;
+}
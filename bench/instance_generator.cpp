@@ -0,0 +1,99 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "instance_generator.hpp"
+
+struct GeneratorOptions {
+    InstanceGenerator::Options instance;
+    int instances = 1;
+    std::filesystem::path output_directory{"generated_instances"};
+};
+
+void printUsage(const char *program_name) {
+    std::cout << "Usage: " << program_name << " [--jobs N] [--processing a-b] [--setup a-b] [--delay a-b] [--arcs N] [--zero-delay-arcs N]\n"
+              << "       [--instances N] [--seed N] [--output directory]\n";
+}
+
+// "a-b", the half-open range the instance names use
+InstanceGenerator::Range parseRange(const std::string& value) {
+    auto dash = value.find('-');
+    if (dash == std::string::npos) {
+        throw std::invalid_argument{"Expected a range a-b, got " + value + ".\n"};
+    }
+
+    return {std::stoi(value.substr(0, dash)), std::stoi(value.substr(dash + 1))};
+}
+
+GeneratorOptions parseOptions(int argc, char *argv[]) {
+    GeneratorOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string option{argv[i]};
+
+        if (i + 1 == argc) {
+            throw std::invalid_argument{"Missing value for " + option + ".\n"};
+        }
+        std::string value{argv[++i]};
+
+        if (option == "--jobs") {
+            options.instance.job_count = std::stoi(value);
+        } else if (option == "--processing") {
+            options.instance.processing_time = parseRange(value);
+        } else if (option == "--setup") {
+            options.instance.setup_time = parseRange(value);
+        } else if (option == "--delay") {
+            options.instance.delay = parseRange(value);
+        } else if (option == "--arcs") {
+            options.instance.arc_count = std::stoi(value);
+        } else if (option == "--zero-delay-arcs") {
+            options.instance.zero_delay_arc_count = std::stoi(value);
+        } else if (option == "--instances") {
+            options.instances = std::stoi(value);
+        } else if (option == "--seed") {
+            options.instance.seed = std::stoul(value);
+        } else if (option == "--output") {
+            options.output_directory = value;
+        } else {
+            throw std::invalid_argument{"Unknown option " + option + ".\n"};
+        }
+    }
+
+    return options;
+}
+
+int main(int argc, char *argv[]) {
+    GeneratorOptions options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const std::exception& exception) {
+        std::cout << exception.what();
+        printUsage(argv[0]);
+
+        return 1;
+    }
+
+    std::filesystem::create_directories(options.output_directory);
+
+    // P1 to P<instances>, like the ten of every bundled configuration
+    for (int number = 1; number <= options.instances; number++) {
+        options.instance.instance_number = number;
+
+        std::string text;
+        try {
+            text = InstanceGenerator::generate(options.instance);
+        } catch (const std::exception& exception) {
+            std::cout << exception.what();
+
+            return 1;
+        }
+
+        auto file_path = options.output_directory / InstanceGenerator::fileName(options.instance);
+        std::ofstream{file_path, std::ios::binary} << text;
+        std::cout << file_path.string() << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dependency_graph.hpp"
+
+int main(int argc, char *argv[]) {
+    if (argc > 3) {
+        std::cout << "Usage: " << argv[0] << " [instance directory] [repetitions]\n";
+
+        return 1;
+    }
+
+    std::filesystem::path instance_directory{argc > 1 ? argv[1] : "instances"};
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 10;
+
+    std::vector<std::filesystem::path> instance_file_paths;
+    std::uintmax_t total_bytes = 0;
+    for (const auto& entry : std::filesystem::directory_iterator{instance_directory}) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            instance_file_paths.push_back(entry.path());
+            total_bytes += entry.file_size();
+        }
+    }
+    std::sort(instance_file_paths.begin(), instance_file_paths.end());
+
+    if (instance_file_paths.empty()) {
+        std::cout << "No instances in " << instance_directory << ".\n";
+
+        return 1;
+    }
+
+    // keeps the loads from being optimized away
+    long long checksum = 0;
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    for (int repetition = 0; repetition < repetitions; repetition++) {
+        for (const auto& instance_file_path : instance_file_paths) {
+            DependencyGraph dependency_graph{instance_file_path};
+            checksum += dependency_graph.getJobCount() + dependency_graph.getSequenceSetupTime()(dependency_graph.getJobCount(), dependency_graph.getJobCount());
+        }
+    }
+    auto text_duration = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time);
+
+    // the binary files go to a scratch directory so the instance directory is left alone
+    auto binary_directory = std::filesystem::temp_directory_path() / "parse-benchmark";
+    std::filesystem::create_directories(binary_directory);
+
+    std::vector<std::filesystem::path> binary_file_paths;
+    for (const auto& instance_file_path : instance_file_paths) {
+        binary_file_paths.push_back(binary_directory / instance_file_path.filename().replace_extension(".bin"));
+        DependencyGraph{instance_file_path}.exportBinary(binary_file_paths.back());
+    }
+
+    start_time = std::chrono::high_resolution_clock::now();
+    for (int repetition = 0; repetition < repetitions; repetition++) {
+        for (const auto& binary_file_path : binary_file_paths) {
+            auto dependency_graph = DependencyGraph::loadBinary(binary_file_path);
+            checksum -= dependency_graph.getJobCount() + dependency_graph.getSequenceSetupTime()(dependency_graph.getJobCount(), dependency_graph.getJobCount());
+        }
+    }
+    auto binary_duration = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time);
+
+    std::filesystem::remove_all(binary_directory);
+
+    double loaded_files = static_cast<double>(instance_file_paths.size()) * repetitions;
+    double parsed_megabytes = static_cast<double>(total_bytes) * repetitions / (1024 * 1024);
+
+    std::cout << instance_file_paths.size() << " files x " << repetitions << " repetitions\n"
+              << "text: " << text_duration.count() << "s, " << loaded_files / text_duration.count() << " files/s, "
+              << parsed_megabytes / text_duration.count() << " MB/s, "
+              << text_duration.count() / loaded_files * 1e6 << "us per file\n"
+              << "binary: " << binary_duration.count() << "s, " << loaded_files / binary_duration.count() << " files/s, "
+              << binary_duration.count() / loaded_files * 1e6 << "us per file\n";
+
+    // both loops have to have seen the same data
+    if (checksum != 0) {
+        std::cout << "Binary instances don't match their text.\n";
+
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <sys/resource.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "candidate_lists.hpp"
+#include "dependency_graph.hpp"
+#include "greedy.hpp"
+#include "instance_generator.hpp"
+#include "local_search.hpp"
+#include "move_evaluator.hpp"
+#include "schedule_evaluator.hpp"
+
+double millisecondsSince(std::chrono::high_resolution_clock::time_point start_time) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+// the high-water mark of the process, which only grows, so the sizes are run smallest first
+double peakResidentMegabytes() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss / 1024.0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 4) {
+        std::cout << "Usage: " << argv[0] << " [largest job count] [descent improvements] [granular k]\n";
+
+        return 1;
+    }
+
+    int largest_job_count = argc > 1 ? std::stoi(argv[1]) : 5000;
+    int max_improvements = argc > 2 ? std::stoi(argv[2]) : 50;
+    int granular_neighbors = argc > 3 ? std::stoi(argv[3]) : 8;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "jobs  graph MB  dense MB  peak RSS MB  parse ms  construct ms  evaluate ms  scan ms  descent ms  lists ms  granular ms  timespan (granular)\n";
+
+    for (int job_count : {100, 200, 500, 1000, 2000, 5000, 10000}) {
+        if (job_count > largest_job_count) {
+            break;
+        }
+
+        // the bundled P(10-20)_S(5-10)_A(20-40) configuration at the bundled arc density
+        InstanceGenerator::Options generator_options;
+        generator_options.job_count = job_count;
+        generator_options.setup_time = {5, 10};
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+        auto dependency_graph = DependencyGraph::fromText(InstanceGenerator::generate(generator_options), InstanceGenerator::fileName(generator_options));
+        double parse_ms = millisecondsSince(start_time);
+
+        // what the graph took with int setups and a dense int delay matrix beside them
+        double graph_megabytes = dependency_graph.getByteSize() / (1024.0 * 1024.0);
+        double dense_megabytes = graph_megabytes + (2.0 * sizeof(int) * job_count * job_count - dependency_graph.getSequenceSetupTime().getBytes().size()) / (1024.0 * 1024.0);
+
+        start_time = std::chrono::high_resolution_clock::now();
+        auto schedule = Greedy::greedyRandomizedAdaptiveProcedure(dependency_graph, 0.3, 1);
+        double construct_ms = millisecondsSince(start_time);
+
+        ScheduleEvaluator schedule_evaluator{dependency_graph};
+        start_time = std::chrono::high_resolution_clock::now();
+        auto evaluation = schedule_evaluator.evaluate(schedule);
+        double evaluate_ms = millisecondsSince(start_time);
+
+        // every swap and insert of the schedule once, through the batch rows
+        MoveEvaluator move_evaluator{dependency_graph};
+        move_evaluator.load(schedule);
+        std::vector<int> deltas(job_count);
+        start_time = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < job_count; i++) {
+            move_evaluator.swapTimespanDeltas(i, deltas);
+            move_evaluator.insertTimespanDeltas(i, deltas);
+        }
+        double scan_ms = millisecondsSince(start_time);
+
+        long long moves_evaluated = 0;
+        start_time = std::chrono::high_resolution_clock::now();
+        LocalSearch::descend(move_evaluator, LocalSearch::defaultNeighborhoods(), moves_evaluated, max_improvements);
+        double descent_ms = millisecondsSince(start_time);
+        int descent_timespan = move_evaluator.getTimespan();
+
+        start_time = std::chrono::high_resolution_clock::now();
+        CandidateLists candidate_lists{dependency_graph, granular_neighbors};
+        double lists_ms = millisecondsSince(start_time);
+
+        // the same descent from the same start, with the swaps and inserts cut to the candidate edges
+        move_evaluator.load(schedule);
+        start_time = std::chrono::high_resolution_clock::now();
+        LocalSearch::descend(move_evaluator, LocalSearch::granularNeighborhoods(candidate_lists), moves_evaluated, max_improvements);
+        double granular_ms = millisecondsSince(start_time);
+
+        std::cout << std::setw(4) << job_count << std::setw(10) << graph_megabytes << std::setw(10) << dense_megabytes
+                  << std::setw(13) << peakResidentMegabytes() << std::setw(10) << parse_ms << std::setw(14) << construct_ms
+                  << std::setw(13) << evaluate_ms << std::setw(9) << scan_ms << std::setw(12) << descent_ms
+                  << std::setw(10) << lists_ms << std::setw(13) << granular_ms << "  " << evaluation.timespan << " -> " << descent_timespan
+                  << " (" << move_evaluator.getTimespan() << ")" << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#ifndef __BEST_SOLUTION_HPP__
+#define __BEST_SOLUTION_HPP__
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Best-so-far slot shared by the search threads without locks. The ranking lives in one atomic
+// key (valid schedules first, then timespan, then the order the offer was made in, which keeps the
+// winner independent of thread timing) and the schedule sits in a buffer guarded by a version
+// counter: writers take it by making the version odd, readers retry while it is odd or changed.
+class BestSolution {
+    public:
+        BestSolution(int job_count);
+
+        // returns whether the schedule became the new best
+        bool offer(const std::vector<int>& schedule, int timespan, bool valid, std::uint32_t order);
+
+        bool empty() const;
+        int getTimespan() const;
+        bool isValid() const;
+        std::vector<int> getSchedule() const;
+
+    private:
+        std::atomic<std::uint64_t> best_key;
+        std::atomic<std::uint64_t> version;
+        std::vector<std::atomic<int>> schedule;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef __CANDIDATE_LISTS_HPP__
+#define __CANDIDATE_LISTS_HPP__
+
+#include <span>
+#include <vector>
+
+#include "dependency_graph.hpp"
+
+// For granular neighborhoods: the size jobs with the cheapest setup out of each job and the size
+// jobs with the cheapest setup into it, cheapest first and ties by id. Nearly every improving move
+// puts a job next to one of these, so only the moves making such an edge need a look. Built once
+// per instance and only read afterwards, so every worker can share one.
+class CandidateLists {
+    public:
+        // size is capped at job_count - 1
+        CandidateLists(const DependencyGraph& dependency_graph, int size);
+
+        int getSize() const;
+
+        // 1-based ids, as everywhere else
+        std::span<const int> getSuccessors(int id) const;
+        std::span<const int> getPredecessors(int id) const;
+
+    private:
+        int size;
+
+        // size entries per job, flat by id - 1
+        std::vector<int> successors;
+        std::vector<int> predecessors;
+};
+
+#endif
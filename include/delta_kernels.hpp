@@ -0,0 +1,57 @@
+#ifndef __DELTA_KERNELS_HPP__
+#define __DELTA_KERNELS_HPP__
+
+#include "setup_matrix.hpp"
+
+// Timespan deltas for a whole row of moves at once, for MoveEvaluator's batch methods. Every
+// setup a move touches is a gathered lookup into the flat setup matrix, so the rows are computed
+// with AVX2 or AVX-512 gathers when the CPU has them and they pay off, and with a plain loop otherwise. All three
+// give the same integers, they only differ in how many lanes are summed at a time. Each kernel is
+// compiled for every width a SetupMatrix can store.
+//
+// Jobs are 1-based ids as everywhere else. entering(job) is setup(before, job), or the processing
+// time of the job when before is 0, that is when the moved position is the first one, since
+// calculateTimespan charges that job twice.
+namespace DeltaKernels {
+    enum class InstructionSet {
+        scalar,
+        avx2,
+        avx512
+    };
+
+    // the best one this CPU supports
+    InstructionSet detect();
+
+    // what the kernels below run with: on first use, whichever of the sets up to detect() is the
+    // fastest on this CPU, since gathers aren't always faster than scalar loads; use() overrides it
+    InstructionSet active();
+
+    // for benchmarks, asking for more than detect() gets detect()
+    void use(InstructionSet instruction_set);
+
+    const char* name(InstructionSet instruction_set);
+
+    // putting the run first..last into the edge previous[k] -> next[k]:
+    // deltas[k] = constant + setup(previous[k], first) + setup(last, next[k]) - setup(previous[k], next[k])
+    void insertionDeltas(
+        const SetupMatrix& setup, const int* previous, const int* next, int count,
+        int first, int last, int constant, int* deltas
+    );
+
+    // exchanging first (followed by after_first) with jobs[k], which sits between previous[k] and next[k]:
+    // deltas[k] = constant + entering(jobs[k]) + setup(jobs[k], after_first) + setup(previous[k], first)
+    //           + setup(first, next[k]) - setup(previous[k], jobs[k]) - setup(jobs[k], next[k])
+    void swapDeltas(
+        const SetupMatrix& setup, const int* processing_time, int before, const int* previous, const int* jobs, const int* next, int count,
+        int first, int after_first, int constant, int* deltas
+    );
+
+    // reversing the segment from first to last[k], which is followed by next[k], with the prefix setup sums at last[k]:
+    // deltas[k] = constant + entering(last[k]) + backward[k] - forward[k] + setup(first, next[k]) - setup(last[k], next[k])
+    void reversalDeltas(
+        const SetupMatrix& setup, const int* processing_time, int before, const int* last, const int* next,
+        const int* forward, const int* backward, int count, int first, int constant, int* deltas
+    );
+}
+
+#endif
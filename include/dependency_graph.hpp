@@ -1,25 +1,87 @@
 #ifndef __DEPENDENCY_GRAPH_HPP__
 #define __DEPENDENCY_GRAPH_HPP__
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
-#include <map>
-#include "job.hpp"
+#include <span>
+#include <string_view>
+#include <vector>
 
+#include "setup_matrix.hpp"
+
+// Read-only instance data. Jobs are identified by 1-based ids (as in the instance files),
+// every per-job array is indexed by id - 1 and every matrix is stored flat in row-major
+// order, so entry (from, to) lives at (from - 1) * getJobCount() + (to - 1). Precedence delays
+// are only kept per arc, next to the adjacency lists, so the only matrix is the setup one.
 class DependencyGraph {
     public:
         DependencyGraph(std::filesystem::path instance_file_path);
 
-        const std::map<int, Job>& getJobs() const;
-        const std::vector<std::vector<int>>& getPrecedenceDelay() const;
-        const std::vector<std::vector<int>>& getSequenceSetupTime() const;
+        // Loads the binary sidecar next to the instance (same name, ".bin" extension) when it is at
+        // least as new as the instance, otherwise parses the text and writes the sidecar for next time.
+        static DependencyGraph load(std::filesystem::path instance_file_path);
+        static DependencyGraph loadBinary(std::filesystem::path binary_file_path);
+
+        // instance text that didn't come from a file, source_name only shows up in parse errors
+        static DependencyGraph fromText(std::string_view text, std::string_view source_name);
+        void exportBinary(std::filesystem::path output_file_path) const;
+
+        int getJobCount() const;
+        std::span<const int> getProcessingTimes() const;
+
+        // CSR adjacency, both lists keep the order in which the arcs appear in the instance file
+        std::span<const int> getDependents(int id) const;
+        std::span<const int> getDependencies(int id) const;
+
+        // the delay of every arc, entry k belonging to getDependents(id)[k] or getDependencies(id)[k]
+        std::span<const int> getDependentDelays(int id) const;
+        std::span<const int> getDependencyDelays(int id) const;
+
+        // zero from every job to itself, parsing rejects anything else, so the first job of a schedule
+        // costs the same whether or not a setup is charged for it
+        const SetupMatrix& getSequenceSetupTime() const;
+
+        // sum of the precedence delays over every path leaving the job, filled once on construction
+        std::span<const int> getCascadedDependentsDelay() const;
+
+        // mean setup time from the job to every other job
+        std::span<const float> getMeanSetupTime() const;
+
+        // FNV-1a over the instance data, the same whether it came from text or from a binary file
+        std::uint64_t getContentHash() const;
+
+        // bytes held by the arrays above
+        std::size_t getByteSize() const;
 
         // used for testing purposes
         void exportGraph(std::filesystem::path output_file_path) const;
 
     private:
-        std::map<int, Job> jobs;
-        std::vector<std::vector<int>> precedence_delay;
-        std::vector<std::vector<int>> sequence_setup_time;
+        int job_count;
+        std::uint64_t content_hash;
+        std::vector<int> processing_time;
+
+        std::vector<int> dependents_offset;
+        std::vector<int> dependents;
+        std::vector<int> dependent_delays;
+        std::vector<int> dependencies_offset;
+        std::vector<int> dependencies;
+        std::vector<int> dependency_delays;
+
+        SetupMatrix sequence_setup_time;
+
+        std::vector<int> cascaded_dependents_delay;
+        std::vector<float> mean_setup_time;
+
+        DependencyGraph() = default;
+
+        void parse(std::string_view text, std::string_view source_name);
+        bool hasConsistentArcs() const;
+        std::vector<int> topologicalOrder() const;
+        void computeContentHash();
+        void computeCascadedDependentsDelay();
+        void computeMeanSetupTime();
 };
 
 #endif
@@ -0,0 +1,38 @@
+#ifndef __ELITE_POOL_HPP__
+#define __ELITE_POOL_HPP__
+
+#include <span>
+#include <vector>
+
+// The best few schedules a run has seen, kept apart from each other so path relinking has
+// somewhere to go. Two schedules are as far apart as the number of positions holding different
+// jobs, and no two members are ever closer than min_distance. A schedule at least that far from
+// every member takes a free place, or once the pool is full the place of the most similar member
+// it beats. One closer than that to some members gets in only by beating each of them, and then
+// replaces them all, so the pool doesn't collapse onto one basin.
+class ElitePool {
+    public:
+        struct Member {
+            std::vector<int> schedule;
+            int timespan;
+            bool valid;
+        };
+
+        ElitePool(int capacity, int min_distance);
+
+        // returns whether the schedule was taken in
+        bool offer(const std::vector<int>& schedule, int timespan, bool valid);
+
+        bool empty() const;
+        int size() const;
+        const Member& get(int index) const;
+
+        static int distance(std::span<const int> first, std::span<const int> second);
+
+    private:
+        int capacity;
+        int min_distance;
+        std::vector<Member> members;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef __EXACT_SOLVER_HPP__
+#define __EXACT_SOLVER_HPP__
+
+#include <chrono>
+#include <vector>
+
+#include "dependency_graph.hpp"
+
+// Depth-first branch-and-bound over schedule prefixes that already satisfy every precedence arc
+// they close, meant for the small instance classes (up to 64 jobs, in practice about 25).
+namespace ExactSolver {
+    constexpr int max_job_count = 64;
+
+    struct Options {
+        int threads = 1;
+
+        // zero means no limit; a run cut short returns its incumbent with optimal set to false
+        std::chrono::milliseconds time_limit{0};
+
+        // prefixes of this length are the units of parallel work
+        int split_depth = 2;
+    };
+
+    struct Result {
+        std::vector<int> schedule;
+        int timespan;
+        bool valid;
+
+        // the search finished, so no valid schedule is shorter than this one (or none exists at all)
+        bool optimal;
+        int lower_bound;
+        long long nodes_explored = 0;
+    };
+
+    // A valid initial_schedule seeds the incumbent, so a good heuristic answer prunes from the start.
+    // The optimal timespan doesn't depend on the thread count, though with ties the schedule may.
+    Result solve(const DependencyGraph& dependency_graph, const Options& options, const std::vector<int>& initial_schedule = {});
+}
+
+#endif
@@ -1,13 +1,29 @@
 #ifndef __GREEDY_HPP__
 #define __GREEDY_HPP__
 
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
 #include "dependency_graph.hpp"
 
 namespace Greedy {
+    // how much a job's cascaded dependents delay pulls it forward in the construction
+    constexpr float dependent_delay_multiplier = 0.4;
+
+    // every pick of one construction draws from a single generator seeded with seed
     std::vector<int> greedyRandomizedAdaptiveProcedure(const DependencyGraph& dependency_graph, float alpha, unsigned int seed);
+
+    // the restricted candidate list draw of the construction, on (id, choice points) pairs it reorders;
+    // SizedKernels builds its lists differently and has to draw the same way
+    int pickCandidate(std::span<std::pair<int, float>> candidate_list, float alpha, std::mt19937& generator);
     int calculateTimespan(const DependencyGraph& dependency_graph, const std::vector<int>& schedule);
     bool checkScheduleValidity(const DependencyGraph& dependency_graph, const std::vector<int>& schedule);
     std::vector<int> localSearch(const DependencyGraph& dependency_graph, float alpha, unsigned int seed);
+
+    // improves an existing schedule, adding to moves_evaluated every move whose timespan change was computed
+    std::vector<int> localSearch(const DependencyGraph& dependency_graph, const std::vector<int>& schedule, long long& moves_evaluated);
 }
 
 #endif
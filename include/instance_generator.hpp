@@ -0,0 +1,38 @@
+#ifndef __INSTANCE_GENERATOR_HPP__
+#define __INSTANCE_GENERATOR_HPP__
+
+#include <string>
+
+// Random instances shaped like the bundled ones, at any size: processing times, setups and arc
+// delays uniform in [min, max), a zero setup diagonal, and arc_count arcs from distinct jobs to a
+// job 1 to 5 ids later, zero_delay_arc_count of them with no delay. The text is in the format
+// DependencyGraph parses and fileName() follows the naming of instances/, so a generated
+// N100_P(10-20)_S(5-10)_A(20-40)_W50_Wo25_P3.txt sits next to the real ones.
+namespace InstanceGenerator {
+    struct Range {
+        int min;
+        int max;
+    };
+
+    struct Options {
+        int job_count = 100;
+        Range processing_time{10, 20};
+        Range setup_time{10, 15};
+        Range delay{20, 40};
+
+        // -1 for the bundled density, job_count / 2 arcs of which half have no delay
+        int arc_count = -1;
+        int zero_delay_arc_count = -1;
+
+        // the P<number> of the name; the same options and seed always give the same instance
+        int instance_number = 1;
+        unsigned int seed = 1;
+    };
+
+    // throws std::invalid_argument when the options can't make an instance
+    std::string generate(const Options& options);
+
+    std::string fileName(const Options& options);
+}
+
+#endif
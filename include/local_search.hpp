@@ -0,0 +1,64 @@
+#ifndef __LOCAL_SEARCH_HPP__
+#define __LOCAL_SEARCH_HPP__
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "dependency_graph.hpp"
+#include "move_evaluator.hpp"
+#include "neighborhood.hpp"
+#include "thread_pool.hpp"
+
+namespace LocalSearch {
+    using Neighborhoods = std::vector<std::unique_ptr<Neighborhood>>;
+
+    // swap, insert, block and reversal, cheapest first
+    Neighborhoods defaultNeighborhoods();
+
+    // the same with the swaps and inserts cut down to those making an edge of candidate_lists, which
+    // has to outlive them; block moves and reversals stay whole
+    Neighborhoods granularNeighborhoods(const CandidateLists& candidate_lists);
+
+    // Variable neighborhood descent: goes back to the first neighborhood after every improvement and
+    // stops once none of them improves, or after max_improvements moves as a guard against long walks.
+    void descend(MoveEvaluator& move_evaluator, const Neighborhoods& neighborhoods, long long& moves_evaluated, int max_improvements = 2000);
+
+    // The same descent with best-improvement: every neighborhood is scanned whole, its rows split
+    // across thread_pool (the calling thread included), and the best move is applied. The moves
+    // taken don't depend on the thread count. It keeps a copy of the schedule per thread, so build
+    // it once and reuse it; a single descent only runs on one thread at a time.
+    class ParallelDescent {
+        public:
+            ParallelDescent(const DependencyGraph& dependency_graph, ThreadPool& thread_pool);
+
+            void descend(MoveEvaluator& move_evaluator, const Neighborhoods& neighborhoods, long long& moves_evaluated, int max_improvements = 2000);
+
+        private:
+            ThreadPool& thread_pool;
+            int slot_count;
+
+            // slot 0 scans with the caller's evaluator, the others with copies brought up to date
+            // whenever the schedule version moved past the one they hold
+            std::vector<MoveEvaluator> slot_evaluators;
+            std::vector<int> slot_versions;
+            std::vector<std::vector<int>> slot_deltas;
+            std::vector<Move> slot_best;
+            std::vector<long long> slot_moves;
+            int version;
+
+            Move best(MoveEvaluator& move_evaluator, const Neighborhood& neighborhood, long long& moves_evaluated);
+    };
+
+    // Path relinking: walks from the loaded schedule to guide, each step swapping into some position
+    // the job guide has there, picking the step that breaks the fewest arcs and then adds the least
+    // timespan, so the walk stays on precedence-feasible schedules as long as it can. Leaves the best
+    // schedule strictly between the two ends loaded, and returns false when there was none.
+    bool relink(MoveEvaluator& move_evaluator, const std::vector<int>& guide, long long& moves_evaluated);
+
+    // Moves strength random jobs to random positions between their last dependency and their first
+    // dependent, so the precedence order survives; delays broken on the way are left to the descent.
+    std::vector<int> perturb(const DependencyGraph& dependency_graph, const std::vector<int>& schedule, int strength, std::mt19937& generator);
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef __LOWER_BOUND_HPP__
+#define __LOWER_BOUND_HPP__
+
+#include "dependency_graph.hpp"
+
+// Timespans no valid schedule can beat, computed from the instance alone. Like
+// Greedy::calculateTimespan they charge the first job's processing time twice.
+namespace LowerBound {
+    struct Bound {
+        // every processing time plus an assignment relaxation of the setups, where each job takes
+        // one predecessor and one successor and the start of the schedule counts as a job whose
+        // edge into the first job costs that job's processing time
+        int setup_assignment;
+
+        // the longest chain of processing times and precedence delays, plus the cheapest first job
+        int critical_path;
+
+        int value;
+    };
+
+    // the assignment is solved exactly up to this many jobs, past it only its row and column minima are used
+    constexpr int max_exact_assignment_jobs = 300;
+
+    Bound compute(const DependencyGraph& dependency_graph);
+
+    // in percent of the bound
+    double gap(int timespan, int bound);
+}
+
+#endif
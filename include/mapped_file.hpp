@@ -0,0 +1,24 @@
+#ifndef __MAPPED_FILE_HPP__
+#define __MAPPED_FILE_HPP__
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+// Read-only memory mapping of a whole file, unmapped on destruction.
+class MappedFile {
+    public:
+        MappedFile(const std::filesystem::path& file_path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::string_view getContents() const;
+
+    private:
+        void *data;
+        std::size_t size;
+};
+
+#endif
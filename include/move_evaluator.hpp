@@ -0,0 +1,101 @@
+#ifndef __MOVE_EVALUATOR_HPP__
+#define __MOVE_EVALUATOR_HPP__
+
+#include <span>
+#include <vector>
+
+#include "dependency_graph.hpp"
+
+// Keeps a schedule together with its prefix finish times and the slack of every precedence arc,
+// so swap, insert, block and reversal moves can be scored without building the resulting schedule.
+//
+// An arc (from, to, delay) holds when "from" is placed before "to" and the time spent between the
+// end of "from" and the start of the job that precedes "to" (setups included) is at least "delay",
+// which is the same rule Greedy::checkScheduleValidity applies to a whole schedule.
+class MoveEvaluator {
+    public:
+        MoveEvaluator(const DependencyGraph& dependency_graph);
+
+        void load(const std::vector<int>& schedule);
+
+        const std::vector<int>& getSchedule() const;
+        int getTimespan() const;
+
+        // where the job with this id sits in the schedule
+        int getPosition(int id) const;
+        int getViolationCount() const;
+
+        // O(1), only the setup edges around the moved jobs are looked at; a block move takes the length
+        // jobs starting at from_position out and puts them back, in order, starting at to_position
+        int swapTimespanDelta(int first_position, int second_position) const;
+        int insertTimespanDelta(int from_position, int to_position) const;
+        int blockTimespanDelta(int from_position, int length, int to_position) const;
+        int reverseTimespanDelta(int first_position, int last_position) const;
+
+        // the same deltas for a whole row of moves at once, through DeltaKernels: swaps and reversals
+        // from first_position to every later position, the job or block at from_position put at every
+        // to_position; deltas[k] is the move whose varying position is k, so it needs job_count entries
+        void swapTimespanDeltas(int first_position, std::span<int> deltas) const;
+        void insertTimespanDeltas(int from_position, std::span<int> deltas) const;
+        void blockTimespanDeltas(int from_position, int length, std::span<int> deltas) const;
+        void reverseTimespanDeltas(int first_position, std::span<int> deltas) const;
+
+        // O(k) over the positions between the moved jobs, returns how many arcs the moved schedule would break
+        int swapViolationCount(int first_position, int second_position);
+        int insertViolationCount(int from_position, int to_position);
+        int blockViolationCount(int from_position, int length, int to_position);
+        int reverseViolationCount(int first_position, int last_position);
+
+        void applySwap(int first_position, int second_position);
+        void applyInsert(int from_position, int to_position);
+        void applyBlock(int from_position, int length, int to_position);
+        void applyReverse(int first_position, int last_position);
+
+    private:
+        int job_count;
+        std::span<const int> processing_time;
+        const SetupMatrix& sequence_setup_time;
+        SetupMatrix::View setup_time;
+
+        // the setups widened to ints, up to wide_setup_jobs jobs: the single moves look them up one at
+        // a time, where a plain load beats the view's shift and mask; empty for larger instances
+        static constexpr int wide_setup_jobs = 1024;
+        std::vector<int> wide_setup_time;
+
+        // arcs numbered in CSR order of their "from" job, plus the incoming arc ids of every job
+        std::vector<int> outgoing_arcs_offset;
+        std::vector<int> arc_from;
+        std::vector<int> arc_to;
+        std::vector<int> arc_delay;
+        std::vector<int> incoming_arcs_offset;
+        std::vector<int> incoming_arcs;
+
+        std::vector<int> schedule;
+        std::vector<int> position;
+        std::vector<int> finish_time;
+        int timespan;
+
+        // setup time summed over the edges before each position, walking forwards and backwards,
+        // so a reversed segment's setups come out of two subtractions
+        std::vector<int> forward_setup_sum;
+        std::vector<int> backward_setup_sum;
+
+        // arcs whose "from" job comes after their "to" job get the lowest possible slack
+        std::vector<int> arc_slack;
+        std::vector<int> arcs_by_slack;
+        std::vector<int> sorted_slack;
+        int violation_count;
+
+        // scratch space for one move, indexed by position - range_begin
+        std::vector<int> range_job;
+        std::vector<int> range_finish_time;
+        std::vector<int> range_stamp;
+        std::vector<int> range_position;
+        int current_stamp;
+
+        void rebuild();
+        int setupTime(int from, int to) const;
+        int violationCount(int range_begin, int range_end);
+};
+
+#endif
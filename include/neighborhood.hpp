@@ -0,0 +1,197 @@
+#ifndef __NEIGHBORHOOD_HPP__
+#define __NEIGHBORHOOD_HPP__
+
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "candidate_lists.hpp"
+#include "move_evaluator.hpp"
+#include "stats.hpp"
+
+// A move of one neighborhood, found by a best-improvement scan. Moves compare by the arcs they
+// break, then by timespan change, then by row and column, so the best one doesn't depend on
+// how the rows were split between threads.
+struct Move {
+    int violations = std::numeric_limits<int>::max();
+    int timespan_delta = std::numeric_limits<int>::max();
+    int row = -1;
+    int column = -1;
+
+    bool found() const;
+    bool operator<(const Move& other) const;
+};
+
+// One family of moves for LocalSearch::descend. improve() scans the family in a fixed order, applies
+// the first move the acceptance rule takes and returns whether it found one, so a new neighborhood
+// only has to enumerate its moves and never repeats the descent loop.
+class Neighborhood {
+    public:
+        virtual ~Neighborhood() = default;
+
+        // adds to moves_evaluated every move whose timespan change was computed
+        virtual bool improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) = 0;
+
+        // For best-improvement scans, which LocalSearch::ParallelDescent splits across threads: the
+        // family is cut into rows that scanRow() looks at on their own, keeping in best the best move
+        // the acceptance rule would take. It only writes to its arguments, so every thread passes
+        // its own evaluator (holding the same schedule) and deltas of job_count entries.
+        virtual int rowCount(int job_count) const = 0;
+        virtual void scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const = 0;
+        virtual void apply(MoveEvaluator& move_evaluator, const Move& move) const = 0;
+
+        // the timer a scan of the family counts towards, taken around a thread's whole share of the
+        // rows rather than every row, so the clock stays out of the row loop
+        virtual Stats::Phase phase() const = 0;
+
+    protected:
+        // one row of timespan deltas from MoveEvaluator's batch methods, sized on first use
+        std::vector<int> timespan_deltas;
+
+        // A move is taken when it breaks fewer precedence arcs, or as many while shortening the timespan,
+        // so a construction that had to relax a delay gets repaired on the way; the arcs are only
+        // checked for moves that could be taken, which with a valid schedule means shorter ones.
+        template<typename ViolationCount>
+        static bool accepts(
+            const MoveEvaluator& move_evaluator, int timespan_delta, ViolationCount violation_count,
+            Stats::Counter feasible_counter, Stats::Counter improving_counter
+        ) {
+            if (timespan_delta >= 0 && move_evaluator.getViolationCount() == 0) {
+                return false;
+            }
+
+            int violations = violation_count();
+            if (violations == 0) {
+                Stats::add(feasible_counter);
+            }
+
+            bool improving = violations < move_evaluator.getViolationCount() || (violations == move_evaluator.getViolationCount() && timespan_delta < 0);
+            if (improving) {
+                Stats::add(improving_counter);
+            }
+
+            return improving;
+        }
+
+        // the same rule for a best-improvement scan, visiting a row's columns in order; once a
+        // move that breaks nothing was found, only shorter ones need their arcs checked
+        template<typename ViolationCount>
+        static void consider(
+            const MoveEvaluator& move_evaluator, int timespan_delta, ViolationCount violation_count, int row, int column,
+            Move& best, Stats::Counter feasible_counter
+        ) {
+            if (timespan_delta >= 0 && move_evaluator.getViolationCount() == 0) {
+                return;
+            }
+            if (best.violations == 0 && timespan_delta >= best.timespan_delta) {
+                return;
+            }
+
+            int violations = violation_count();
+            if (violations == 0) {
+                Stats::add(feasible_counter);
+            }
+
+            bool improving = violations < move_evaluator.getViolationCount() || (violations == move_evaluator.getViolationCount() && timespan_delta < 0);
+            Move move{violations, timespan_delta, row, column};
+            if (improving && move < best) {
+                best = move;
+            }
+        }
+};
+
+// exchanges the jobs at two positions
+class SwapNeighborhood final : public Neighborhood {
+    public:
+        bool improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) override;
+
+        int rowCount(int job_count) const override;
+        void scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const override;
+        void apply(MoveEvaluator& move_evaluator, const Move& move) const override;
+        Stats::Phase phase() const override;
+};
+
+// moves one job to another position
+class InsertNeighborhood final : public Neighborhood {
+    public:
+        bool improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) override;
+
+        int rowCount(int job_count) const override;
+        void scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const override;
+        void apply(MoveEvaluator& move_evaluator, const Move& move) const override;
+        Stats::Phase phase() const override;
+};
+
+// The swaps that put a job right after one of its candidate predecessors or right before one of
+// its candidate successors, about 2 k per job instead of job_count; each is scored on its own.
+class GranularSwapNeighborhood final : public Neighborhood {
+    public:
+        GranularSwapNeighborhood(const CandidateLists& candidate_lists);
+
+        bool improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) override;
+
+        int rowCount(int job_count) const override;
+        void scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const override;
+        void apply(MoveEvaluator& move_evaluator, const Move& move) const override;
+        Stats::Phase phase() const override;
+
+    private:
+        const CandidateLists& candidate_lists;
+
+        // calls visit(column) for every swap of row's job that makes a candidate edge, until it returns true
+        template<typename Visit>
+        bool forEachMove(const MoveEvaluator& move_evaluator, int row, Visit visit) const;
+};
+
+// the same for moving a job right after a candidate predecessor or right before a candidate successor
+class GranularInsertNeighborhood final : public Neighborhood {
+    public:
+        GranularInsertNeighborhood(const CandidateLists& candidate_lists);
+
+        bool improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) override;
+
+        int rowCount(int job_count) const override;
+        void scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const override;
+        void apply(MoveEvaluator& move_evaluator, const Move& move) const override;
+        Stats::Phase phase() const override;
+
+    private:
+        const CandidateLists& candidate_lists;
+
+        template<typename Visit>
+        bool forEachMove(const MoveEvaluator& move_evaluator, int row, Visit visit) const;
+};
+
+// or-opt: moves a run of 2 to max_length consecutive jobs elsewhere, keeping their order
+class BlockNeighborhood final : public Neighborhood {
+    public:
+        BlockNeighborhood(int max_length = 3);
+
+        bool improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) override;
+
+        int rowCount(int job_count) const override;
+        void scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const override;
+        void apply(MoveEvaluator& move_evaluator, const Move& move) const override;
+        Stats::Phase phase() const override;
+
+    private:
+        int max_length;
+};
+
+// reverses a segment of 3 to max_length jobs, 0 meaning any length; two jobs are already a swap
+class ReversalNeighborhood final : public Neighborhood {
+    public:
+        ReversalNeighborhood(int max_length = 0);
+
+        bool improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) override;
+
+        int rowCount(int job_count) const override;
+        void scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const override;
+        void apply(MoveEvaluator& move_evaluator, const Move& move) const override;
+        Stats::Phase phase() const override;
+
+    private:
+        int max_length;
+};
+
+#endif
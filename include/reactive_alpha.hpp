@@ -0,0 +1,39 @@
+#ifndef __REACTIVE_ALPHA_HPP__
+#define __REACTIVE_ALPHA_HPP__
+
+#include <array>
+#include <random>
+
+// Reactive GRASP: alpha comes from a fixed set of values, each drawn with a probability that
+// follows how good the schedules it led to were. Every update_period records the probability of a
+// value becomes proportional to its share of valid schedules times (best / mean)^amplification,
+// mean being its mean valid timespan and best the lowest of all values, mixed with a tenth of the
+// uniform distribution so that no value stops being tried. Until then every value is as likely.
+class ReactiveAlpha {
+    public:
+        static constexpr std::array<float, 6> values{0.05, 0.1, 0.2, 0.3, 0.4, 0.6};
+
+        ReactiveAlpha();
+
+        // an index into values
+        int draw(std::mt19937& generator);
+
+        // the locally searched schedule a construction with values[index] ended in
+        void record(int index, int timespan, bool valid);
+
+    private:
+        static constexpr int update_period = 2 * values.size();
+        static constexpr double amplification = 10;
+
+        std::array<int, values.size()> runs;
+        std::array<int, values.size()> valid_runs;
+        std::array<long long, values.size()> timespan_sum;
+        int best_timespan;
+        int pending_records;
+
+        std::discrete_distribution<> distribution;
+
+        void update();
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef __SCHEDULE_EVALUATOR_HPP__
+#define __SCHEDULE_EVALUATOR_HPP__
+
+#include <span>
+#include <vector>
+
+#include "dependency_graph.hpp"
+
+// Validates and scores whole schedules in one pass over arrays sized once on construction, so an
+// evaluation allocates nothing. It gives the same answers as Greedy::calculateTimespan and
+// Greedy::checkScheduleValidity, given the zero setup from a job to itself that parsing enforces
+// (calculateTimespan charges one before the first job, the evaluators don't); keep one per
+// thread, since evaluating writes to the arrays.
+class ScheduleEvaluator {
+    public:
+        struct Evaluation {
+            int timespan;  // 0 when the schedule isn't a permutation of the jobs
+            bool valid;
+        };
+
+        ScheduleEvaluator(const DependencyGraph& dependency_graph);
+
+        Evaluation evaluate(std::span<const int> schedule);
+
+    private:
+        int job_count;
+        std::span<const int> processing_time;
+        const SetupMatrix& sequence_setup_time;
+        const DependencyGraph& dependency_graph;
+
+        // a job is placed in the current evaluation when its stamp matches, so nothing is cleared between calls
+        std::vector<int> placed_stamp;
+        std::vector<int> finish_time;
+        int current_stamp;
+};
+
+// valid schedules rank first, then the shorter timespan; takes anything with those two fields, so
+// evaluations, elite members and solver results all compare the same way
+template <typename First, typename Second>
+bool isBetter(const First& first, const Second& second) {
+    if (first.valid != second.valid) {
+        return first.valid;
+    }
+
+    return first.timespan < second.timespan;
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef __SETUP_MATRIX_HPP__
+#define __SETUP_MATRIX_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+// The sequence setup times, flat in row-major order like every other matrix (entry (from, to) at
+// (from - 1) * job_count + (to - 1)), but stored in the narrowest width that holds all of them:
+// 8 or 16 unsigned bits, or plain ints when a setup is negative or too large. With thousands of
+// jobs this matrix is nearly all of an instance, and the bundled setup ranges fit in a byte.
+// Each array ends in 4 zero bytes past the last entry, so a 32-bit load at any entry stays inside it.
+class SetupMatrix {
+    public:
+        enum class Width {
+            bits8,
+            bits16,
+            bits32
+        };
+
+        SetupMatrix();
+
+        // values holds job_count * job_count entries, the width is picked from them
+        SetupMatrix(int job_count, std::span<const int> values);
+
+        // the entries as getBytes() gave them out
+        SetupMatrix(int job_count, Width width, std::span<const char> bytes);
+
+        // the view points into the arrays, so a copy has to point into its own
+        SetupMatrix(const SetupMatrix& other);
+        SetupMatrix(SetupMatrix&& other) = default;
+        SetupMatrix& operator=(const SetupMatrix& other);
+        SetupMatrix& operator=(SetupMatrix&& other) = default;
+
+        // Reads entries without going through the matrix, for the hot loops to keep by value. The
+        // width is a shift and a mask rather than a branch: 32 bits are read at the entry and only
+        // the entry's own are kept.
+        struct View {
+            const char* entries;
+            int job_count;
+            int entry_shift;
+            std::uint32_t entry_mask;
+
+            // 1-based ids, as everywhere else
+            int operator()(int from, int to) const {
+                std::size_t offset = static_cast<std::size_t>((from - 1) * this->job_count + (to - 1)) << this->entry_shift;
+
+                std::uint32_t value;
+                std::memcpy(&value, this->entries + offset, sizeof(value));
+
+                return static_cast<int>(value & this->entry_mask);
+            }
+        };
+
+        int operator()(int from, int to) const {
+            return this->view(from, to);
+        }
+
+        // valid for as long as the matrix is
+        View getView() const;
+
+        // calls function with a pointer to the entries in their stored type, so a loop over them can
+        // have the width resolved once, outside of it
+        template<typename Function>
+        decltype(auto) visit(Function&& function) const {
+            switch (this->width) {
+                case Width::bits8:
+                    return function(this->values8.data());
+                case Width::bits16:
+                    return function(this->values16.data());
+                default:
+                    return function(this->values32.data());
+            }
+        }
+
+        int getJobCount() const;
+        Width getWidth() const;
+
+        // the entries in their stored width, without the padding
+        std::span<const char> getBytes() const;
+
+        static std::size_t entrySize(Width width);
+
+    private:
+        int job_count;
+        Width width;
+        View view;
+
+        // only the one of the current width is filled
+        std::vector<std::uint8_t> values8;
+        std::vector<std::uint16_t> values16;
+        std::vector<int> values32;
+
+        void bindView();
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef __SIZED_KERNELS_HPP__
+#define __SIZED_KERNELS_HPP__
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "dependency_graph.hpp"
+#include "schedule_evaluator.hpp"
+
+// The GRASP construction and the whole-schedule evaluation, compiled once per size class (up to
+// 15, 31, 63 and 127 jobs). make() picks the smallest class the instance fits in, which copies the
+// matrices into std::arrays with a power-of-two row stride (row and column 0 standing for "no job",
+// so the first position needs no branch) and keeps its working state in fixed-size arrays and
+// bitsets on the stack. Larger instances get the dynamic path, Greedy::greedyRandomizedAdaptiveProcedure
+// and ScheduleEvaluator.
+// Every class returns exactly what the dynamic path would, for the same alpha and seed.
+//
+// Build one per thread and reuse it, the constructor copies the matrices.
+class SizedKernels {
+    public:
+        static std::unique_ptr<SizedKernels> make(const DependencyGraph& dependency_graph);
+
+        virtual ~SizedKernels() = default;
+
+        // the most jobs this class takes, 0 for the dynamic path
+        virtual int getMaxJobCount() const = 0;
+
+        virtual std::vector<int> construct(float alpha, unsigned int seed) = 0;
+        virtual ScheduleEvaluator::Evaluation evaluate(std::span<const int> schedule) = 0;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef __SOLUTION_STORE_HPP__
+#define __SOLUTION_STORE_HPP__
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+// The best valid schedule found so far for every instance, kept on disk across runs in a directory
+// of small text files named after DependencyGraph::getContentHash, so a renamed or moved instance
+// file still finds its record and an edited one doesn't. A record reads
+//
+//     timespan <timespan>
+//     seed <seed of the run that found it>
+//     parameters <solver options of that run>
+//     schedule <job ids>
+//
+// Several processes can share a directory: an update holds a lock file next to the record while it
+// compares and replaces it, and the new record is written under a name of its own and renamed
+// over the old one, so readers, which take no lock, never see a partial file.
+class SolutionStore {
+    public:
+        struct Record {
+            std::vector<int> schedule;
+            int timespan;
+            unsigned int seed;
+            std::string parameters;
+        };
+
+        // creates the directory when it isn't there
+        SolutionStore(std::filesystem::path directory);
+
+        // nothing when there is no record or it can't be read; the schedule is as stored, so check it
+        // against the instance before trusting it
+        std::optional<Record> find(std::uint64_t content_hash) const;
+
+        // replaces the stored record when this one's timespan is shorter, or when there was none or
+        // check turned it down (a record that doesn't hold for the instance it's filed under has to go
+        // whatever timespan it claims), and returns whether it did; throws std::runtime_error when the
+        // directory can't be written
+        bool offer(std::uint64_t content_hash, const Record& record, const std::function<bool(const Record&)>& check);
+
+    private:
+        std::filesystem::path directory;
+
+        std::filesystem::path recordPath(std::uint64_t content_hash) const;
+};
+
+#endif
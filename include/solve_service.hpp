@@ -0,0 +1,55 @@
+#ifndef __SOLVE_SERVICE_HPP__
+#define __SOLVE_SERVICE_HPP__
+
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+
+#include "solver.hpp"
+#include "thread_pool.hpp"
+
+// Solves a stream of requests on one pool that lives as long as the service, so a pipeline pays for
+// process startup and thread creation once. A request is a line holding an instance path, or
+// "inline" followed by the instance text and a line "end", then any solver options for that
+// request alone ("--time-limit 500 --seed 7"); blank lines and lines starting with '#' are skipped.
+// Every request gets one line back, in the order they finish:
+//
+//     <request number> <instance>: <timespan>[ (invalid)][ (optimal)] (gap X%) (Nms) (seed S): <schedule>
+//     <request number> <instance>: error <message>
+//
+// where requests are numbered from 1 per input stream and the time leaves out the wait in the queue.
+class SolveService {
+    public:
+        struct Options {
+            int workers = 1;
+
+            // requests queued or running at once, 0 meaning twice the workers; reading stops while it's full
+            int queue_capacity = 0;
+
+            // what every request starts from before its own options
+            Solver::Options solver;
+            bool iterations_given = false;
+        };
+
+        SolveService(const Options& options);
+
+        // answers every request read from input_fd on output_fd, returning once the input ended and
+        // all of its requests were answered; neither descriptor is closed
+        void serve(int input_fd, int output_fd);
+
+        // serves every connection to a Unix socket at socket_path (replacing whatever is there) on a
+        // thread of its own, and never returns
+        void listen(const std::filesystem::path& socket_path);
+
+    private:
+        ThreadPool thread_pool;
+        int queue_capacity;
+        Solver::Options default_options;
+        bool default_iterations_given;
+
+        std::mutex queue_mutex;
+        std::condition_variable queue_changed;
+        int queued_requests;
+};
+
+#endif
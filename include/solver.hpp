@@ -0,0 +1,98 @@
+#ifndef __SOLVER_HPP__
+#define __SOLVER_HPP__
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dependency_graph.hpp"
+#include "thread_pool.hpp"
+
+namespace Solver {
+    struct Options {
+        int iterations = 1;
+        int threads = 1;
+        unsigned int seed = 3;
+        float alpha = 0.3;
+
+        // draws every start's alpha from ReactiveAlpha::values instead, learning per worker which pay off
+        bool reactive_alpha = false;
+
+        // after each GRASP start, this many rounds of perturbing the start's best schedule and searching again
+        int perturbations = 0;
+
+        // with a pool of this many elite schedules per worker, every start is also relinked with a random
+        // member of it (LocalSearch::relink, starting from the better of the two) and the best
+        // intermediate schedule searched again; zero turns it off
+        int elite_size = 0;
+
+        // after every start's descent, this many iterations of tabu search over the swaps and inserts
+        // (TabuSearch), cut short by the time limit, and a descent from the best schedule it went
+        // through; zero turns it off
+        int tabu_iterations = 0;
+
+        // with k > 0, the swaps and inserts of the local search only try moves that put a job next to one
+        // of its k cheapest setup partners (LocalSearch::granularNeighborhoods); zero tries them all
+        int granular_neighbors = 0;
+
+        // zero means no limit; otherwise the run stops at the first iteration boundary past the limit
+        std::chrono::milliseconds time_limit{0};
+
+        // when set, every new best is appended as "elapsed_ms,timespan,valid,iteration"
+        std::filesystem::path trace_file_path;
+
+        // when set, a SolutionStore directory: the run's first start is the instance's stored schedule
+        // when it is still valid, and a better valid result replaces the record at the end, so the
+        // result depends on what earlier runs stored there as well
+        std::filesystem::path solution_store_path;
+
+        // one start at a time, each descent scanning its neighborhoods best-improvement across all the
+        // threads (LocalSearch::ParallelDescent) instead of one first-improvement start per thread
+        bool parallel_neighborhoods = false;
+
+        // stop once a valid schedule reaches LowerBound::compute's bound, since nothing can beat it; the
+        // iterations before the first one that reached it still run, so the result stays the same
+        bool stop_at_lower_bound = true;
+    };
+
+    struct Result {
+        std::vector<int> schedule;
+        int timespan;
+        bool valid;
+        int lower_bound = 0;
+
+        // summed over every start, so with several threads these are CPU times; perturbing counts as construction
+        std::chrono::nanoseconds construction_time{0};
+        std::chrono::nanoseconds local_search_time{0};
+        long long moves_evaluated = 0;
+    };
+
+    // Runs options.iterations local searches over options.threads workers and keeps the best one. Each
+    // starts from a GRASP construction or, for options.perturbations rounds after one, from a perturbed
+    // copy of that start's best schedule. Iteration i constructs from a seed split off (options.seed, i),
+    // so it builds the same schedule whichever worker runs it, and worker w runs iterations w, w + threads, ...
+    // drawing everything else from a stream split off (options.seed, w), so a given seed and thread count
+    // always gives the same result unless a time limit cuts the run (stopping at the lower bound keeps it).
+    // With options.parallel_neighborhoods there is a single worker, so the result doesn't depend on the thread count either.
+    Result multiStart(const DependencyGraph& dependency_graph, const Options& options);
+
+    // The same on a pool that outlives the run, as the solve service keeps one for every request. The
+    // workers go through ThreadPool::parallelFor, so several runs can share the pool, and the calling
+    // thread works too.
+    Result multiStart(const DependencyGraph& dependency_graph, const Options& options, ThreadPool& thread_pool);
+
+    // Applies one "--name value" command line option to options and returns whether it was one of the
+    // solver's (--iterations, --threads, --seed, --alpha, --perturbations, --elite, --tabu,
+    // --granular, --time-limit, --trace, --store), "--alpha reactive" turning on
+    // options.reactive_alpha; a bad value, an iteration or thread count below 1, an alpha outside
+    // [0, 1], or a negative perturbation count, elite size, tabu iteration count, candidate list
+    // length or time limit throws std::invalid_argument. iterations_given is set by --iterations.
+    bool parseOption(Options& options, std::string_view name, const std::string& value, bool& iterations_given);
+
+    // with a time limit the deadline ends the run, unless an iteration count was asked for too
+    void applyTimeLimit(Options& options, bool iterations_given);
+}
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef __STATS_HPP__
+#define __STATS_HPP__
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+
+// Hot-path counters and phase timers behind --stats. Every thread bumps a slot of its own, so
+// counting costs a thread-local add, and the slots are only summed when a report is asked for.
+// Built without SCHEDULING_STATS every call below is an empty inline function.
+namespace Stats {
+    enum Counter {
+        // a move is feasible when its arcs were checked (the local search skips that for moves that
+        // can't be taken) and it breaks none of them, and improving when the local search takes it
+        swap_moves_generated,
+        swap_moves_feasible,
+        swap_moves_improving,
+        insert_moves_generated,
+        insert_moves_feasible,
+        insert_moves_improving,
+        block_moves_generated,
+        block_moves_feasible,
+        block_moves_improving,
+        reversal_moves_generated,
+        reversal_moves_feasible,
+        reversal_moves_improving,
+
+        // tabu search steps, and moves it passed over because they led back to a recent schedule
+        tabu_iterations,
+        tabu_revisits,
+
+        validity_checks,
+        validity_rejections,
+        constructions,
+        delay_relaxations,
+        binary_cache_hits,
+        text_parses,
+
+        // through the replaced operator new, see stats.cpp
+        allocations,
+        allocated_bytes,
+
+        counter_count
+    };
+
+    enum Phase {
+        text_parse,
+        binary_load,
+        construction,
+        swap_phase,
+        insert_phase,
+        block_phase,
+        reversal_phase,
+        tabu_phase,
+
+        phase_count
+    };
+
+    struct Slot {
+        std::array<std::atomic<long long>, counter_count> counters{};
+        std::array<std::atomic<long long>, phase_count> phase_nanoseconds{};
+    };
+
+    struct Report {
+        std::array<long long, counter_count> counters{};
+        std::array<std::chrono::nanoseconds, phase_count> phase_times{};
+    };
+
+#ifdef SCHEDULING_STATS
+    // set on the first record or allocation of each thread; when the thread exits, its counts move to
+    // a shared retired slot, which it counts into from then on, and its slot is reused
+    inline thread_local Slot *local_slot = nullptr;
+    Slot *registerSlot();
+
+    // only the owning thread writes a slot, so a relaxed load and store is enough
+    inline void add(Counter counter, long long amount = 1) {
+        if (local_slot == nullptr) {
+            local_slot = registerSlot();
+        }
+
+        auto& value = local_slot->counters[counter];
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    class ScopedTimer {
+        public:
+            ScopedTimer(Phase phase) : phase{phase}, start_time{std::chrono::steady_clock::now()} {}
+
+            ~ScopedTimer() {
+                if (local_slot == nullptr) {
+                    local_slot = registerSlot();
+                }
+
+                auto& value = local_slot->phase_nanoseconds[phase];
+                auto elapsed = std::chrono::steady_clock::now() - start_time;
+                value.store(value.load(std::memory_order_relaxed) + std::chrono::nanoseconds{elapsed}.count(), std::memory_order_relaxed);
+            }
+
+        private:
+            Phase phase;
+            std::chrono::steady_clock::time_point start_time;
+    };
+
+    constexpr bool enabled = true;
+#else
+    inline void add(Counter, long long = 1) {}
+
+    class ScopedTimer {
+        public:
+            ScopedTimer(Phase) {}
+    };
+
+    constexpr bool enabled = false;
+#endif
+
+    // sums every slot, threads still running may be caught halfway through
+    Report collect();
+    void reset();
+
+    void print(std::ostream& output, const Report& report);
+    void printJson(std::ostream& output, const Report& report);
+}
+
+#endif
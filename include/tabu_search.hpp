@@ -0,0 +1,66 @@
+#ifndef __TABU_SEARCH_HPP__
+#define __TABU_SEARCH_HPP__
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "move_evaluator.hpp"
+#include "neighborhood.hpp"
+
+// Tabu search over the swap and insert moves, to keep going where the descent stops. Every
+// iteration takes the best move of both neighborhoods that isn't tabu, by the arcs it breaks and then
+// by timespan change, even when it makes the schedule worse. Moving a job off a position makes
+// putting it back there tabu for a few iterations (a job-position attribute, held in a flat table),
+// and a move is also passed over when it leads to a schedule seen recently, which a Zobrist hash of
+// the schedule finds in O(1) for a swap. A tabu move is still taken when it leads to a valid schedule
+// shorter than the best of the run (aspiration).
+//
+// Build one per thread and reuse it, the tables are sized once for the instance.
+class TabuSearch {
+    public:
+        TabuSearch(int job_count);
+
+        // Runs from the loaded schedule for at most iterations iterations, or until deadline, and leaves
+        // the best schedule it went through loaded; adds every move whose timespan change was computed
+        // to moves_evaluated. generator draws the tenures.
+        void run(
+            MoveEvaluator& move_evaluator, int iterations, std::chrono::steady_clock::time_point deadline,
+            std::mt19937& generator, long long& moves_evaluated
+        );
+
+    private:
+        int job_count;
+
+        // past this many jobs, positions share a tabu entry in runs of position_stride, so the table
+        // stays at job_count * max_position_slots entries
+        static constexpr int max_position_slots = 256;
+        int position_stride;
+        int position_slots;
+
+        // the iteration until which putting job id at a position is tabu, at
+        // (id - 1) * position_slots + position / position_stride; iterations count on across runs,
+        // so the table never has to be cleared
+        std::vector<long long> tabu_until;
+        long long iteration;
+
+        // direct-mapped table of the hashes of recent schedules, newer ones overwriting older ones
+        static constexpr int visited_slots = 1 << 16;
+        std::vector<std::uint64_t> visited;
+
+        std::vector<int> deltas;
+        std::vector<int> best_schedule;
+
+        bool isTabu(int id, int position) const;
+        void makeTabu(int id, int position, int tenure);
+
+        // the hash of a schedule XORs key(id, position) over its positions
+        static std::uint64_t key(int id, int position);
+        std::uint64_t hashSwap(std::uint64_t hash, const std::vector<int>& schedule, int first_position, int second_position) const;
+        std::uint64_t hashInsert(std::uint64_t hash, const std::vector<int>& schedule, int from_position, int to_position) const;
+        bool wasVisited(std::uint64_t hash) const;
+        void markVisited(std::uint64_t hash);
+};
+
+#endif
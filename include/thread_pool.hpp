@@ -0,0 +1,45 @@
+#ifndef __THREAD_POOL_HPP__
+#define __THREAD_POOL_HPP__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads fed from one task queue. Threads are created once and live as long
+// as the pool, so callers submit work instead of spawning threads per iteration.
+class ThreadPool {
+    public:
+        ThreadPool(int thread_count);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        int getThreadCount() const;
+
+        void submit(std::function<void()> task);
+
+        // blocks until every task submitted so far has finished
+        void wait();
+
+        // Runs task(0) to task(count - 1) across the pool and returns once all of them have finished.
+        // The calling thread takes indices too, so a pool task can call this without waiting on
+        // workers that are all busy; unlike wait(), it only waits for its own indices.
+        void parallelFor(int count, const std::function<void(int)>& task);
+
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex tasks_mutex;
+        std::condition_variable task_available;
+        std::condition_variable tasks_finished;
+        int running_tasks;
+        bool stopping;
+
+        void workerLoop();
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "best_solution.hpp"
+
+#include <limits>
+
+constexpr std::uint64_t empty_key = std::numeric_limits<std::uint64_t>::max();
+constexpr std::uint64_t invalid_flag = std::uint64_t{1} << 63;
+
+BestSolution::BestSolution(int job_count): best_key{empty_key}, version{0}, schedule(job_count) {}
+
+bool BestSolution::offer(const std::vector<int>& schedule, int timespan, bool valid, std::uint32_t order) {
+    std::uint64_t key = (valid ? 0 : invalid_flag) | (static_cast<std::uint64_t>(timespan) << 32) | order;
+
+    std::uint64_t current_key = this->best_key.load(std::memory_order_acquire);
+    do {
+        if (key >= current_key) {
+            return false;
+        }
+    } while (!this->best_key.compare_exchange_weak(current_key, key, std::memory_order_acq_rel));
+
+    // take the buffer, a better offer that got in first has already written itself and wins
+    std::uint64_t current_version = this->version.load(std::memory_order_relaxed);
+    do {
+        current_version &= ~std::uint64_t{1};
+    } while (!this->version.compare_exchange_weak(current_version, current_version + 1, std::memory_order_acquire));
+
+    if (this->best_key.load(std::memory_order_acquire) == key) {
+        for (int i = 0; i < schedule.size(); i++) {
+            this->schedule[i].store(schedule[i], std::memory_order_relaxed);
+        }
+    }
+
+    this->version.store(current_version + 2, std::memory_order_release);
+
+    return true;
+}
+
+bool BestSolution::empty() const {
+    return this->best_key.load(std::memory_order_acquire) == empty_key;
+}
+
+int BestSolution::getTimespan() const {
+    return static_cast<int>((this->best_key.load(std::memory_order_acquire) & ~invalid_flag) >> 32);
+}
+
+bool BestSolution::isValid() const {
+    return (this->best_key.load(std::memory_order_acquire) & invalid_flag) == 0;
+}
+
+std::vector<int> BestSolution::getSchedule() const {
+    std::vector<int> result(this->schedule.size());
+
+    while (true) {
+        std::uint64_t version_before = this->version.load(std::memory_order_acquire);
+        if (version_before & 1) {
+            continue;
+        }
+
+        for (int i = 0; i < result.size(); i++) {
+            result[i] = this->schedule[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (this->version.load(std::memory_order_relaxed) == version_before) {
+            return result;
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#include "candidate_lists.hpp"
+
+#include <algorithm>
+#include <utility>
+
+// The size cheapest partners offered so far, by setup and then id. Partners are offered by increasing
+// id, so one tied with the last kept partner never gets in, and past the first few offers nearly
+// every one is turned away by a single comparison.
+class Cheapest {
+    public:
+        Cheapest(int size): size{size}, count{0}, partners(size) {}
+
+        void clear() {
+            this->count = 0;
+        }
+
+        void offer(int setup, int id) {
+            if (this->count == this->size && setup >= this->partners[this->size - 1].first) {
+                return;
+            }
+
+            int k = this->count < this->size ? this->count++ : this->size - 1;
+            for (; k > 0 && setup < this->partners[k - 1].first; k--) {
+                this->partners[k] = this->partners[k - 1];
+            }
+            this->partners[k] = {setup, id};
+        }
+
+        void copyIds(int* target) const {
+            for (int k = 0; k < this->size; k++) {
+                target[k] = this->partners[k].second;
+            }
+        }
+
+    private:
+        int size;
+        int count;
+        std::vector<std::pair<int, int>> partners;
+};
+
+CandidateLists::CandidateLists(const DependencyGraph& dependency_graph, int size) {
+    int job_count = dependency_graph.getJobCount();
+
+    this->size = std::clamp(size, 0, job_count - 1);
+    this->successors.resize(static_cast<std::size_t>(job_count) * this->size);
+    this->predecessors.resize(static_cast<std::size_t>(job_count) * this->size);
+
+    if (this->size == 0) {
+        return;
+    }
+
+    dependency_graph.getSequenceSetupTime().visit([&](const auto* setup_time) {
+        Cheapest cheapest{this->size};
+
+        for (int id = 1; id <= job_count; id++) {
+            const auto* row = &setup_time[static_cast<std::size_t>(id - 1) * job_count];
+
+            cheapest.clear();
+            for (int other = 1; other <= job_count; other++) {
+                if (other != id) {
+                    cheapest.offer(row[other - 1], other);
+                }
+            }
+            cheapest.copyIds(&this->successors[(id - 1) * this->size]);
+        }
+
+        // a column of the matrix is job_count entries apart, so the predecessors are gathered a
+        // block of columns at a time, reading each row once per block
+        constexpr int block_columns = 64;
+        std::vector<int> block(static_cast<std::size_t>(block_columns) * job_count);
+        for (int block_begin = 1; block_begin <= job_count; block_begin += block_columns) {
+            int block_end = std::min(block_begin + block_columns, job_count + 1);
+
+            for (int other = 1; other <= job_count; other++) {
+                const auto* row = &setup_time[static_cast<std::size_t>(other - 1) * job_count];
+                for (int id = block_begin; id < block_end; id++) {
+                    block[(id - block_begin) * job_count + (other - 1)] = row[id - 1];
+                }
+            }
+
+            for (int id = block_begin; id < block_end; id++) {
+                const int* column = &block[(id - block_begin) * job_count];
+
+                cheapest.clear();
+                for (int other = 1; other <= job_count; other++) {
+                    if (other != id) {
+                        cheapest.offer(column[other - 1], other);
+                    }
+                }
+                cheapest.copyIds(&this->predecessors[(id - 1) * this->size]);
+            }
+        }
+    });
+}
+
+int CandidateLists::getSize() const {
+    return this->size;
+}
+
+std::span<const int> CandidateLists::getSuccessors(int id) const {
+    return {this->successors.data() + (id - 1) * this->size, static_cast<std::size_t>(this->size)};
+}
+
+std::span<const int> CandidateLists::getPredecessors(int id) const {
+    return {this->predecessors.data() + (id - 1) * this->size, static_cast<std::size_t>(this->size)};
+}
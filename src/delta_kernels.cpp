@@ -0,0 +1,480 @@
+#include "delta_kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DELTA_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+using DeltaKernels::InstructionSet;
+
+// T is the stored setup type (see SetupMatrix) and E the entering row's, which is T for a setup
+// row and int for the processing times
+
+template<typename T>
+inline int setupTime(const T* setup, int job_count, int from, int to) {
+    return setup[(from - 1) * job_count + (to - 1)];
+}
+
+template<typename T>
+void scalarInsertionDeltas(
+    const T* setup, int job_count, const int* previous, const int* next, int count,
+    int first, int last, int constant, int* deltas
+) {
+    for (int k = 0; k < count; k++) {
+        deltas[k] = constant + setupTime(setup, job_count, previous[k], first) + setupTime(setup, job_count, last, next[k])
+                  - setupTime(setup, job_count, previous[k], next[k]);
+    }
+}
+
+template<typename T, typename E>
+void scalarSwapDeltas(
+    const T* setup, int job_count, const E* entering_row, const int* previous, const int* jobs, const int* next, int count,
+    int first, int after_first, int constant, int* deltas
+) {
+    for (int k = 0; k < count; k++) {
+        deltas[k] = constant + entering_row[jobs[k] - 1] + setupTime(setup, job_count, jobs[k], after_first)
+                  + setupTime(setup, job_count, previous[k], first) + setupTime(setup, job_count, first, next[k])
+                  - setupTime(setup, job_count, previous[k], jobs[k]) - setupTime(setup, job_count, jobs[k], next[k]);
+    }
+}
+
+template<typename T, typename E>
+void scalarReversalDeltas(
+    const T* setup, int job_count, const E* entering_row, const int* last, const int* next,
+    const int* forward, const int* backward, int count, int first, int constant, int* deltas
+) {
+    for (int k = 0; k < count; k++) {
+        deltas[k] = constant + entering_row[last[k] - 1] + backward[k] - forward[k]
+                  + setupTime(setup, job_count, first, next[k]) - setupTime(setup, job_count, last[k], next[k]);
+    }
+}
+
+#ifdef DELTA_KERNELS_X86
+
+// The vector kernels sum the same terms in the same order as the scalar ones, lane by lane,
+// and leave the last count % lanes moves to them. Rows of a fixed job are gathered from that
+// row's start, so only the lookups between two varying jobs multiply an index. Entries narrower
+// than an int are gathered as the 32 bits starting at them and masked, which the padding at the
+// end of a SetupMatrix keeps inside the array.
+
+template<typename T>
+__attribute__((target("avx2")))
+inline __m256i gather256(const T* values, __m256i index) {
+    if constexpr (sizeof(T) == sizeof(int)) {
+        return _mm256_i32gather_epi32(reinterpret_cast<const int*>(values), index, 4);
+    } else {
+        __m256i offset = _mm256_slli_epi32(index, sizeof(T) / 2);
+        __m256i loaded = _mm256_i32gather_epi32(reinterpret_cast<const int*>(values), offset, 1);
+
+        return _mm256_and_si256(loaded, _mm256_set1_epi32((1 << (8 * sizeof(T))) - 1));
+    }
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+inline __m256i gatherSetup256(const T* setup, __m256i job_count, __m256i from, __m256i to) {
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(from, one), job_count), _mm256_sub_epi32(to, one));
+
+    return gather256(setup, index);
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+inline __m256i gatherRow256(const T* row, __m256i to) {
+    return gather256(row, _mm256_sub_epi32(to, _mm256_set1_epi32(1)));
+}
+
+// the column of a fixed job, setup(from, to) for every lane's from
+template<typename T>
+__attribute__((target("avx2")))
+inline __m256i gatherColumn256(const T* setup, __m256i job_count, __m256i from, int to) {
+    __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(from, _mm256_set1_epi32(1)), job_count), _mm256_set1_epi32(to - 1));
+
+    return gather256(setup, index);
+}
+
+__attribute__((target("avx2")))
+inline __m256i load256(const int* values) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+void avx2InsertionDeltas(
+    const T* setup, int job_count, const int* previous, const int* next, int count,
+    int first, int last, int constant, int* deltas
+) {
+    __m256i job_counts = _mm256_set1_epi32(job_count);
+    const T* last_row = setup + (last - 1) * job_count;
+
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256i previous_jobs = load256(previous + k);
+        __m256i next_jobs = load256(next + k);
+
+        __m256i delta = _mm256_set1_epi32(constant);
+        delta = _mm256_add_epi32(delta, gatherColumn256(setup, job_counts, previous_jobs, first));
+        delta = _mm256_add_epi32(delta, gatherRow256(last_row, next_jobs));
+        delta = _mm256_sub_epi32(delta, gatherSetup256(setup, job_counts, previous_jobs, next_jobs));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(deltas + k), delta);
+    }
+
+    scalarInsertionDeltas(setup, job_count, previous + k, next + k, count - k, first, last, constant, deltas + k);
+}
+
+template<typename T, typename E>
+__attribute__((target("avx2")))
+void avx2SwapDeltas(
+    const T* setup, int job_count, const E* entering_row, const int* previous, const int* jobs, const int* next, int count,
+    int first, int after_first, int constant, int* deltas
+) {
+    __m256i job_counts = _mm256_set1_epi32(job_count);
+    const T* first_row = setup + (first - 1) * job_count;
+
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256i previous_jobs = load256(previous + k);
+        __m256i moved_jobs = load256(jobs + k);
+        __m256i next_jobs = load256(next + k);
+
+        __m256i delta = _mm256_set1_epi32(constant);
+        delta = _mm256_add_epi32(delta, gatherRow256(entering_row, moved_jobs));
+        delta = _mm256_add_epi32(delta, gatherColumn256(setup, job_counts, moved_jobs, after_first));
+        delta = _mm256_add_epi32(delta, gatherColumn256(setup, job_counts, previous_jobs, first));
+        delta = _mm256_add_epi32(delta, gatherRow256(first_row, next_jobs));
+        delta = _mm256_sub_epi32(delta, gatherSetup256(setup, job_counts, previous_jobs, moved_jobs));
+        delta = _mm256_sub_epi32(delta, gatherSetup256(setup, job_counts, moved_jobs, next_jobs));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(deltas + k), delta);
+    }
+
+    scalarSwapDeltas(setup, job_count, entering_row, previous + k, jobs + k, next + k, count - k, first, after_first, constant, deltas + k);
+}
+
+template<typename T, typename E>
+__attribute__((target("avx2")))
+void avx2ReversalDeltas(
+    const T* setup, int job_count, const E* entering_row, const int* last, const int* next,
+    const int* forward, const int* backward, int count, int first, int constant, int* deltas
+) {
+    __m256i job_counts = _mm256_set1_epi32(job_count);
+    const T* first_row = setup + (first - 1) * job_count;
+
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256i last_jobs = load256(last + k);
+        __m256i next_jobs = load256(next + k);
+
+        __m256i delta = _mm256_set1_epi32(constant);
+        delta = _mm256_add_epi32(delta, gatherRow256(entering_row, last_jobs));
+        delta = _mm256_add_epi32(delta, load256(backward + k));
+        delta = _mm256_sub_epi32(delta, load256(forward + k));
+        delta = _mm256_add_epi32(delta, gatherRow256(first_row, next_jobs));
+        delta = _mm256_sub_epi32(delta, gatherSetup256(setup, job_counts, last_jobs, next_jobs));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(deltas + k), delta);
+    }
+
+    scalarReversalDeltas(setup, job_count, entering_row, last + k, next + k, forward + k, backward + k, count - k, first, constant, deltas + k);
+}
+
+// The masked gather with every lane on and the byte offset left to the gather's scale, since GCC's
+// plain gather and immediate shift start from an undefined register it then warns may be uninitialized.
+template<typename T>
+__attribute__((target("avx512f")))
+inline __m512i gather512(const T* values, __m512i index) {
+    if constexpr (sizeof(T) == sizeof(int)) {
+        return _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xffff, index, values, 4);
+    } else {
+        __m512i loaded = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xffff, index, values, sizeof(T));
+
+        return _mm512_and_si512(loaded, _mm512_set1_epi32((1 << (8 * sizeof(T))) - 1));
+    }
+}
+
+template<typename T>
+__attribute__((target("avx512f")))
+inline __m512i gatherSetup512(const T* setup, __m512i job_count, __m512i from, __m512i to) {
+    __m512i one = _mm512_set1_epi32(1);
+    __m512i index = _mm512_add_epi32(_mm512_mullo_epi32(_mm512_sub_epi32(from, one), job_count), _mm512_sub_epi32(to, one));
+
+    return gather512(setup, index);
+}
+
+template<typename T>
+__attribute__((target("avx512f")))
+inline __m512i gatherRow512(const T* row, __m512i to) {
+    return gather512(row, _mm512_sub_epi32(to, _mm512_set1_epi32(1)));
+}
+
+template<typename T>
+__attribute__((target("avx512f")))
+inline __m512i gatherColumn512(const T* setup, __m512i job_count, __m512i from, int to) {
+    __m512i index = _mm512_add_epi32(_mm512_mullo_epi32(_mm512_sub_epi32(from, _mm512_set1_epi32(1)), job_count), _mm512_set1_epi32(to - 1));
+
+    return gather512(setup, index);
+}
+
+template<typename T>
+__attribute__((target("avx512f")))
+void avx512InsertionDeltas(
+    const T* setup, int job_count, const int* previous, const int* next, int count,
+    int first, int last, int constant, int* deltas
+) {
+    __m512i job_counts = _mm512_set1_epi32(job_count);
+    const T* last_row = setup + (last - 1) * job_count;
+
+    int k = 0;
+    for (; k + 16 <= count; k += 16) {
+        __m512i previous_jobs = _mm512_loadu_si512(previous + k);
+        __m512i next_jobs = _mm512_loadu_si512(next + k);
+
+        __m512i delta = _mm512_set1_epi32(constant);
+        delta = _mm512_add_epi32(delta, gatherColumn512(setup, job_counts, previous_jobs, first));
+        delta = _mm512_add_epi32(delta, gatherRow512(last_row, next_jobs));
+        delta = _mm512_sub_epi32(delta, gatherSetup512(setup, job_counts, previous_jobs, next_jobs));
+
+        _mm512_storeu_si512(deltas + k, delta);
+    }
+
+    avx2InsertionDeltas(setup, job_count, previous + k, next + k, count - k, first, last, constant, deltas + k);
+}
+
+template<typename T, typename E>
+__attribute__((target("avx512f")))
+void avx512SwapDeltas(
+    const T* setup, int job_count, const E* entering_row, const int* previous, const int* jobs, const int* next, int count,
+    int first, int after_first, int constant, int* deltas
+) {
+    __m512i job_counts = _mm512_set1_epi32(job_count);
+    const T* first_row = setup + (first - 1) * job_count;
+
+    int k = 0;
+    for (; k + 16 <= count; k += 16) {
+        __m512i previous_jobs = _mm512_loadu_si512(previous + k);
+        __m512i moved_jobs = _mm512_loadu_si512(jobs + k);
+        __m512i next_jobs = _mm512_loadu_si512(next + k);
+
+        __m512i delta = _mm512_set1_epi32(constant);
+        delta = _mm512_add_epi32(delta, gatherRow512(entering_row, moved_jobs));
+        delta = _mm512_add_epi32(delta, gatherColumn512(setup, job_counts, moved_jobs, after_first));
+        delta = _mm512_add_epi32(delta, gatherColumn512(setup, job_counts, previous_jobs, first));
+        delta = _mm512_add_epi32(delta, gatherRow512(first_row, next_jobs));
+        delta = _mm512_sub_epi32(delta, gatherSetup512(setup, job_counts, previous_jobs, moved_jobs));
+        delta = _mm512_sub_epi32(delta, gatherSetup512(setup, job_counts, moved_jobs, next_jobs));
+
+        _mm512_storeu_si512(deltas + k, delta);
+    }
+
+    avx2SwapDeltas(setup, job_count, entering_row, previous + k, jobs + k, next + k, count - k, first, after_first, constant, deltas + k);
+}
+
+template<typename T, typename E>
+__attribute__((target("avx512f")))
+void avx512ReversalDeltas(
+    const T* setup, int job_count, const E* entering_row, const int* last, const int* next,
+    const int* forward, const int* backward, int count, int first, int constant, int* deltas
+) {
+    __m512i job_counts = _mm512_set1_epi32(job_count);
+    const T* first_row = setup + (first - 1) * job_count;
+
+    int k = 0;
+    for (; k + 16 <= count; k += 16) {
+        __m512i last_jobs = _mm512_loadu_si512(last + k);
+        __m512i next_jobs = _mm512_loadu_si512(next + k);
+
+        __m512i delta = _mm512_set1_epi32(constant);
+        delta = _mm512_add_epi32(delta, gatherRow512(entering_row, last_jobs));
+        delta = _mm512_add_epi32(delta, _mm512_loadu_si512(backward + k));
+        delta = _mm512_sub_epi32(delta, _mm512_loadu_si512(forward + k));
+        delta = _mm512_add_epi32(delta, gatherRow512(first_row, next_jobs));
+        delta = _mm512_sub_epi32(delta, gatherSetup512(setup, job_counts, last_jobs, next_jobs));
+
+        _mm512_storeu_si512(deltas + k, delta);
+    }
+
+    avx2ReversalDeltas(setup, job_count, entering_row, last + k, next + k, forward + k, backward + k, count - k, first, constant, deltas + k);
+}
+
+#endif
+
+void dispatchInsertionDeltas(
+    InstructionSet instruction_set, const SetupMatrix& setup, const int* previous, const int* next, int count,
+    int first, int last, int constant, int* deltas
+) {
+    int job_count = setup.getJobCount();
+
+    setup.visit([&](const auto* values) {
+#ifdef DELTA_KERNELS_X86
+        switch (instruction_set) {
+            case InstructionSet::avx512:
+                return avx512InsertionDeltas(values, job_count, previous, next, count, first, last, constant, deltas);
+            case InstructionSet::avx2:
+                return avx2InsertionDeltas(values, job_count, previous, next, count, first, last, constant, deltas);
+            default:
+                break;
+        }
+#endif
+
+        scalarInsertionDeltas(values, job_count, previous, next, count, first, last, constant, deltas);
+    });
+}
+
+InstructionSet DeltaKernels::detect() {
+#ifdef DELTA_KERNELS_X86
+    if (__builtin_cpu_supports("avx512f")) {
+        return InstructionSet::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return InstructionSet::avx2;
+    }
+#endif
+
+    return InstructionSet::scalar;
+}
+
+std::atomic<InstructionSet> active_instruction_set{InstructionSet::scalar};
+
+// Gathers are slow on some CPUs that have them (microcoded by the Gather Data Sampling fix, or
+// split in two on AVX-512 parts), so the instruction set the kernels start with is whichever
+// ran a synthetic row of insertion deltas the fastest here, which takes well under a millisecond.
+InstructionSet fastestInstructionSet() {
+    constexpr int job_count = 128;
+    std::vector<int> setup_values(job_count * job_count);
+    std::vector<int> previous(job_count);
+    std::vector<int> next(job_count);
+    std::vector<int> deltas(job_count);
+    for (int i = 0; i < setup_values.size(); i++) {
+        setup_values[i] = i % 97;
+    }
+    SetupMatrix setup{job_count, setup_values};
+    for (int k = 0; k < job_count; k++) {
+        previous[k] = (k * 37) % job_count + 1;
+        next[k] = (k * 53 + 11) % job_count + 1;
+    }
+
+    InstructionSet fastest = InstructionSet::scalar;
+    auto fastest_time = std::chrono::nanoseconds::max();
+    for (auto instruction_set : {InstructionSet::scalar, InstructionSet::avx2, InstructionSet::avx512}) {
+        if (instruction_set > DeltaKernels::detect()) {
+            break;
+        }
+
+        auto best_time = std::chrono::nanoseconds::max();
+        for (int repetition = 0; repetition < 16; repetition++) {
+            auto start_time = std::chrono::steady_clock::now();
+            for (int first = 1; first <= 16; first++) {
+                dispatchInsertionDeltas(instruction_set, setup, previous.data(), next.data(), job_count, first, first + 1, 0, deltas.data());
+            }
+            best_time = std::min(best_time, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time));
+        }
+
+        // a wider set has to win clearly, timer noise shouldn't flip the choice
+        if (best_time * 10 < fastest_time * 9) {
+            fastest = instruction_set;
+            fastest_time = best_time;
+        }
+    }
+
+    return fastest;
+}
+
+std::once_flag calibrated;
+
+InstructionSet DeltaKernels::active() {
+    std::call_once(calibrated, [] {
+        active_instruction_set.store(fastestInstructionSet(), std::memory_order_relaxed);
+    });
+
+    return active_instruction_set.load(std::memory_order_relaxed);
+}
+
+void DeltaKernels::use(InstructionSet instruction_set) {
+    active();
+    active_instruction_set.store(std::min(instruction_set, detect()), std::memory_order_relaxed);
+}
+
+const char* DeltaKernels::name(InstructionSet instruction_set) {
+    switch (instruction_set) {
+        case InstructionSet::avx2:
+            return "avx2";
+        case InstructionSet::avx512:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
+
+void DeltaKernels::insertionDeltas(
+    const SetupMatrix& setup, const int* previous, const int* next, int count,
+    int first, int last, int constant, int* deltas
+) {
+    dispatchInsertionDeltas(active(), setup, previous, next, count, first, last, constant, deltas);
+}
+
+// calls kernel with the setups in their stored type and the entering row, so every pair of the
+// two types gets a kernel of its own
+template<typename Kernel>
+void withEnteringRow(const SetupMatrix& setup, const int* processing_time, int before, Kernel&& kernel) {
+    int job_count = setup.getJobCount();
+
+    setup.visit([&](const auto* values) {
+        if (before == 0) {
+            kernel(values, job_count, processing_time);
+        } else {
+            kernel(values, job_count, values + (before - 1) * job_count);
+        }
+    });
+}
+
+void DeltaKernels::swapDeltas(
+    const SetupMatrix& setup, const int* processing_time, int before, const int* previous, const int* jobs, const int* next, int count,
+    int first, int after_first, int constant, int* deltas
+) {
+    auto instruction_set = active();
+
+    withEnteringRow(setup, processing_time, before, [&](const auto* values, int job_count, const auto* entering_row) {
+#ifdef DELTA_KERNELS_X86
+        switch (instruction_set) {
+            case InstructionSet::avx512:
+                return avx512SwapDeltas(values, job_count, entering_row, previous, jobs, next, count, first, after_first, constant, deltas);
+            case InstructionSet::avx2:
+                return avx2SwapDeltas(values, job_count, entering_row, previous, jobs, next, count, first, after_first, constant, deltas);
+            default:
+                break;
+        }
+#endif
+
+        scalarSwapDeltas(values, job_count, entering_row, previous, jobs, next, count, first, after_first, constant, deltas);
+    });
+}
+
+void DeltaKernels::reversalDeltas(
+    const SetupMatrix& setup, const int* processing_time, int before, const int* last, const int* next,
+    const int* forward, const int* backward, int count, int first, int constant, int* deltas
+) {
+    auto instruction_set = active();
+
+    withEnteringRow(setup, processing_time, before, [&](const auto* values, int job_count, const auto* entering_row) {
+#ifdef DELTA_KERNELS_X86
+        switch (instruction_set) {
+            case InstructionSet::avx512:
+                return avx512ReversalDeltas(values, job_count, entering_row, last, next, forward, backward, count, first, constant, deltas);
+            case InstructionSet::avx2:
+                return avx2ReversalDeltas(values, job_count, entering_row, last, next, forward, backward, count, first, constant, deltas);
+            default:
+                break;
+        }
+#endif
+
+        scalarReversalDeltas(values, job_count, entering_row, last, next, forward, backward, count, first, constant, deltas);
+    });
+}
@@ -1,136 +1,627 @@
 #include "dependency_graph.hpp"
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+
+#include "mapped_file.hpp"
+#include "stats.hpp"
+
+// Single forward pass over an instance's text that keeps the current line and column for error messages.
+class InstanceScanner {
+    public:
+        InstanceScanner(std::string_view text, std::string_view source_name):
+            current{text.data()}, end{text.data() + text.size()}, line_start{text.data()}, line{1}, source_name{source_name} {}
+
+        bool atEnd() const {
+            return this->current == this->end;
+        }
+
+        bool startsWith(std::string_view literal) const {
+            return std::string_view{this->current, this->end}.starts_with(literal);
+        }
+
+        void expect(std::string_view literal) {
+            if (!this->startsWith(literal)) {
+                this->fail("expected \"" + std::string{literal} + "\"");
+            }
+
+            this->current += literal.size();
+        }
+
+        int readInt() {
+            this->skipSpaces();
+
+            int value;
+            auto [position, error] = std::from_chars(this->current, this->end, value);
+            if (error != std::errc{}) {
+                this->fail("expected a number");
+            }
+
+            this->current = position;
+            this->skipSpaces();
+
+            return value;
+        }
+
+        void endLine() {
+            this->skipSpaces();
+
+            if (this->atEnd()) {
+                return;
+            }
+
+            if (*this->current != '\n') {
+                this->fail("expected the end of the line");
+            }
+
+            this->current++;
+            this->line++;
+            this->line_start = this->current;
+        }
+
+        void skipBlankLines() {
+            while (!this->atEnd() && (*this->current == '\n' || *this->current == '\r' || *this->current == ' ' || *this->current == '\t')) {
+                this->endLine();
+            }
+        }
+
+        [[noreturn]] void fail(const std::string& message) const {
+            throw std::invalid_argument{
+                std::string{this->source_name} + ":" + std::to_string(this->line) + ":" + std::to_string(this->current - this->line_start + 1) + ": " + message + ".\n"
+            };
+        }
+
+    private:
+        const char *current;
+        const char *end;
+        const char *line_start;
+        int line;
+        std::string_view source_name;
+
+        void skipSpaces() {
+            while (this->current != this->end && (*this->current == ' ' || *this->current == '\t' || *this->current == '\r')) {
+                this->current++;
+            }
+        }
+};
 
 DependencyGraph::DependencyGraph(std::filesystem::path instance_file_path) {
     if (!std::filesystem::is_regular_file(instance_file_path)) {
         throw std::invalid_argument{"Given file path doesn't point to a regular file.\n"};
     }
 
-    std::ifstream file_reader{instance_file_path};
-    std::string current_line;
+    Stats::ScopedTimer timer{Stats::text_parse};
+    Stats::add(Stats::text_parses);
+
+    MappedFile instance_file{instance_file_path};
+    this->parse(instance_file.getContents(), instance_file_path.string());
+
+    this->computeContentHash();
+    this->computeCascadedDependentsDelay();
+    this->computeMeanSetupTime();
+}
+
+DependencyGraph DependencyGraph::fromText(std::string_view text, std::string_view source_name) {
+    Stats::ScopedTimer timer{Stats::text_parse};
+    Stats::add(Stats::text_parses);
+
+    DependencyGraph dependency_graph;
+    dependency_graph.parse(text, source_name);
+
+    dependency_graph.computeContentHash();
+    dependency_graph.computeCascadedDependentsDelay();
+    dependency_graph.computeMeanSetupTime();
+
+    return dependency_graph;
+}
+
+// Binary layout: this header, then processing_time[job_count], dependents_offset[job_count + 1],
+// dependents[arc_count], dependent_delays[arc_count], dependencies_offset[job_count + 1],
+// dependencies[arc_count], dependency_delays[arc_count] and cascaded_dependents_delay[job_count] as
+// native ints, mean_setup_time[job_count] as native floats, and last the setup matrix in its own
+// width. Everything derived is stored too, so a load only copies and checks the arcs.
+struct BinaryHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t job_count;
+    std::uint32_t arc_count;
+    std::uint64_t content_hash;
+    std::uint32_t setup_entry_size;  // 1, 2 or 4 bytes
+    std::uint32_t reserved;
+};
+
+constexpr std::uint32_t binary_magic = 0x47434954;  // "TICG" when read in little endian
+constexpr std::uint32_t binary_version = 3;
+
+DependencyGraph DependencyGraph::load(std::filesystem::path instance_file_path) {
+    if (instance_file_path.extension() == ".bin") {
+        return DependencyGraph::loadBinary(instance_file_path);
+    }
+
+    auto cache_file_path = std::filesystem::path{instance_file_path}.replace_extension(".bin");
+
+    std::error_code instance_error;
+    std::error_code cache_error;
+    auto instance_time = std::filesystem::last_write_time(instance_file_path, instance_error);
+    auto cache_time = std::filesystem::last_write_time(cache_file_path, cache_error);
+    if (!instance_error && !cache_error && cache_time >= instance_time) {
+        try {
+            auto dependency_graph = DependencyGraph::loadBinary(cache_file_path);
+            Stats::add(Stats::binary_cache_hits);
+
+            return dependency_graph;
+        } catch (const std::exception&) {
+            // damaged or written by another version, rebuilt below
+        }
+    }
+
+    DependencyGraph dependency_graph{instance_file_path};
+
+    // written under a name of its own and renamed, so concurrent runs never read a partial file
+    auto temporary_file_path = cache_file_path;
+    temporary_file_path += "." + std::to_string(getpid()) + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+    try {
+        dependency_graph.exportBinary(temporary_file_path);
+        std::filesystem::rename(temporary_file_path, cache_file_path);
+    } catch (const std::exception&) {
+        // an unwritable instance directory only costs the cache
+        std::filesystem::remove(temporary_file_path, cache_error);
+    }
+
+    return dependency_graph;
+}
+
+DependencyGraph DependencyGraph::loadBinary(std::filesystem::path binary_file_path) {
+    Stats::ScopedTimer timer{Stats::binary_load};
+
+    MappedFile binary_file{binary_file_path};
+    auto contents = binary_file.getContents();
+
+    BinaryHeader header;
+    if (contents.size() < sizeof(header)) {
+        throw std::invalid_argument{binary_file_path.string() + " is too short to be a binary instance.\n"};
+    }
+    std::memcpy(&header, contents.data(), sizeof(header));
+
+    if (header.magic != binary_magic || header.version != binary_version) {
+        throw std::invalid_argument{binary_file_path.string() + " isn't a binary instance of version " + std::to_string(binary_version) + ".\n"};
+    }
+
+    SetupMatrix::Width setup_width;
+    switch (header.setup_entry_size) {
+        case 1:
+            setup_width = SetupMatrix::Width::bits8;
+            break;
+        case 2:
+            setup_width = SetupMatrix::Width::bits16;
+            break;
+        case 4:
+            setup_width = SetupMatrix::Width::bits32;
+            break;
+        default:
+            throw std::invalid_argument{binary_file_path.string() + " has setups of an unknown width.\n"};
+    }
+
+    // every job and arc takes at least an int of the file, which also keeps the sizes below from overflowing
+    std::size_t job_count = header.job_count;
+    std::size_t arc_count = header.arc_count;
+    if (job_count < 1 || job_count > contents.size() / sizeof(int) || arc_count > contents.size() / sizeof(int)) {
+        throw std::invalid_argument{binary_file_path.string() + " doesn't match the size its header promises.\n"};
+    }
+
+    std::size_t value_count = 3 * job_count + 2 * (job_count + 1) + 4 * arc_count;
+    std::size_t setup_bytes = job_count * job_count * header.setup_entry_size;
+    if (contents.size() != sizeof(header) + value_count * sizeof(int) + setup_bytes) {
+        throw std::invalid_argument{binary_file_path.string() + " doesn't match the size its header promises.\n"};
+    }
+
+    const char *cursor = contents.data() + sizeof(header);
+    auto read_array = [&]<typename T>(std::vector<T>& target, std::size_t count) {
+        target.resize(count);
+        std::memcpy(target.data(), cursor, count * sizeof(T));
+        cursor += count * sizeof(T);
+    };
+
+    DependencyGraph dependency_graph;
+
+    dependency_graph.job_count = job_count;
+    read_array(dependency_graph.processing_time, job_count);
+    read_array(dependency_graph.dependents_offset, job_count + 1);
+    read_array(dependency_graph.dependents, arc_count);
+    read_array(dependency_graph.dependent_delays, arc_count);
+    read_array(dependency_graph.dependencies_offset, job_count + 1);
+    read_array(dependency_graph.dependencies, arc_count);
+    read_array(dependency_graph.dependency_delays, arc_count);
+    read_array(dependency_graph.cascaded_dependents_delay, job_count);
+    read_array(dependency_graph.mean_setup_time, job_count);
+    dependency_graph.sequence_setup_time = SetupMatrix{static_cast<int>(job_count), setup_width, std::span{cursor, setup_bytes}};
+
+    // a damaged file of the right size would otherwise index past the arrays; load() reparses the text then
+    if (!dependency_graph.hasConsistentArcs()) {
+        throw std::invalid_argument{binary_file_path.string() + " holds arcs that don't fit its jobs.\n"};
+    }
+    for (int id = 1; id <= dependency_graph.job_count; id++) {
+        if (dependency_graph.sequence_setup_time(id, id) != 0) {
+            throw std::invalid_argument{binary_file_path.string() + " holds a job's setup to itself.\n"};
+        }
+    }
+
+    // the hash was computed from these same arrays when the file was written, rehashing them would
+    // cost as much as the rest of the load
+    dependency_graph.content_hash = header.content_hash;
+
+    return dependency_graph;
+}
+
+void DependencyGraph::exportBinary(std::filesystem::path output_file_path) const {
+    BinaryHeader header{
+        binary_magic,
+        binary_version,
+        static_cast<std::uint32_t>(this->job_count),
+        static_cast<std::uint32_t>(this->dependents.size()),
+        this->content_hash,
+        static_cast<std::uint32_t>(SetupMatrix::entrySize(this->sequence_setup_time.getWidth())),
+        0
+    };
+
+    std::ofstream file_writer{output_file_path, std::ios::binary};
+    auto write_array = [&](std::span<const int> values) {
+        file_writer.write(reinterpret_cast<const char *>(values.data()), values.size_bytes());
+    };
+
+    file_writer.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    write_array(this->processing_time);
+    write_array(this->dependents_offset);
+    write_array(this->dependents);
+    write_array(this->dependent_delays);
+    write_array(this->dependencies_offset);
+    write_array(this->dependencies);
+    write_array(this->dependency_delays);
+    write_array(this->cascaded_dependents_delay);
+    file_writer.write(reinterpret_cast<const char *>(this->mean_setup_time.data()), this->mean_setup_time.size() * sizeof(float));
+
+    auto setup_bytes = this->sequence_setup_time.getBytes();
+    file_writer.write(setup_bytes.data(), setup_bytes.size());
+
+    file_writer.close();
+    if (!file_writer) {
+        throw std::runtime_error{"Couldn't write " + output_file_path.string() + ".\n"};
+    }
+}
+
+void DependencyGraph::parse(std::string_view text, std::string_view source_name) {
+    InstanceScanner scanner{text, source_name};
 
     // Parse first line "R=[number]"
-    std::getline(file_reader, current_line);
-    std::string job_amount_string = current_line.substr(current_line.find("=") + 1);
-    int job_amount = std::stoi(job_amount_string);
+    scanner.expect("R=");
+    int job_amount = scanner.readInt();
+    if (job_amount < 1) {
+        scanner.fail("job amount has to be positive");
+    }
+    scanner.endLine();
+
+    this->job_count = job_amount;
+    this->processing_time.resize(job_amount);
+
+    // Parse second line "Pi=([Number],[Number],...)"
+    scanner.expect("Pi=(");
+    for (int i = 0; i < job_amount; i++) {
+        if (i != 0) {
+            scanner.expect(",");
+        }
+
+        this->processing_time[i] = scanner.readInt();
+    }
+    scanner.expect(")");
+    scanner.endLine();
+
+    // Parse next lines ("[number],[number],[number]") until "Sij="
+    scanner.expect("A=");
+    scanner.endLine();
+
+    std::vector<std::tuple<int, int, int>> arcs;
+
+    while (!scanner.startsWith("Sij=")) {
+        if (scanner.atEnd()) {
+            scanner.fail("expected \"Sij=\"");
+        }
+
+        int depended_on = scanner.readInt();
+        scanner.expect(",");
+        int dependent = scanner.readInt();
+        scanner.expect(",");
+        int precedence_delay = scanner.readInt();
+
+        if (depended_on < 1 || depended_on > job_amount || dependent < 1 || dependent > job_amount || depended_on == dependent) {
+            scanner.fail("arc between unknown jobs");
+        }
+        scanner.endLine();
+
+        arcs.emplace_back(depended_on, dependent, precedence_delay);
+    }
+
+    // Build both CSR lists with a counting pass, which keeps the arcs in file order
+    this->dependents_offset.assign(job_amount + 1, 0);
+    this->dependencies_offset.assign(job_amount + 1, 0);
+    for (auto [depended_on, dependent, precedence_delay] : arcs) {
+        this->dependents_offset[depended_on]++;
+        this->dependencies_offset[dependent]++;
+    }
 
     for (int i = 0; i < job_amount; i++) {
-        std::vector<int> precedence_delay;
+        this->dependents_offset[i + 1] += this->dependents_offset[i];
+        this->dependencies_offset[i + 1] += this->dependencies_offset[i];
+    }
+
+    this->dependents.resize(arcs.size());
+    this->dependent_delays.resize(arcs.size());
+    this->dependencies.resize(arcs.size());
+    this->dependency_delays.resize(arcs.size());
+    std::vector<int> dependents_fill{this->dependents_offset.cbegin(), std::prev(this->dependents_offset.cend())};
+    std::vector<int> dependencies_fill{this->dependencies_offset.cbegin(), std::prev(this->dependencies_offset.cend())};
+    for (auto [depended_on, dependent, precedence_delay] : arcs) {
+        this->dependent_delays[dependents_fill[depended_on - 1]] = precedence_delay;
+        this->dependents[dependents_fill[depended_on - 1]++] = dependent;
+        this->dependency_delays[dependencies_fill[dependent - 1]] = precedence_delay;
+        this->dependencies[dependencies_fill[dependent - 1]++] = depended_on;
+    }
+
+    // Parse next lines ("[number],[number],[number],..."), one matrix row each
+    scanner.expect("Sij=");
+    scanner.endLine();
 
+    // read as ints first, the width only shows once every setup has been seen
+    std::vector<int> sequence_setup_time(job_amount * job_amount);
+    for (int i = 0; i < job_amount; i++) {
         for (int j = 0; j < job_amount; j++) {
-            if (i == j) {
-                precedence_delay.push_back(-2);
-            } else {
-                precedence_delay.push_back(-1);
+            if (j != 0) {
+                scanner.expect(",");
+            }
+
+            sequence_setup_time[i * job_amount + j] = scanner.readInt();
+            if (i == j && sequence_setup_time[i * job_amount + j] != 0) {
+                scanner.fail("a job's setup to itself has to be 0");
             }
         }
+        scanner.endLine();
+    }
+    this->sequence_setup_time = SetupMatrix{job_amount, sequence_setup_time};
 
-        this->precedence_delay.push_back(precedence_delay);
+    scanner.skipBlankLines();
+    if (!scanner.atEnd()) {
+        scanner.fail("unexpected content after the setup matrix");
     }
+}
 
-    // Parse second line "Pi=([Number],[Number],...)"
-    std::getline(file_reader, current_line);
-    current_line = current_line.substr(current_line.find("(") + 1, current_line.size() - 1);  // gets only the comma separated numbers, removing both "(" and ")"
+// Both CSR lists well formed over the same arcs: offsets from 0 up to the arc count, ids of other
+// jobs, every job listing as many dependencies as there are arcs into it, and no cycle, so every
+// lookup stays inside the arrays and the search terminates. Linear in the arcs.
+bool DependencyGraph::hasConsistentArcs() const {
+    int arc_count = this->dependents.size();
 
-    for (int i = 1; i < job_amount; i++) {  // last value is handled separately
-        auto comma_position = current_line.find(",");
+    for (const auto* offsets : {&this->dependents_offset, &this->dependencies_offset}) {
+        if ((*offsets)[0] != 0 || (*offsets)[this->job_count] != arc_count) {
+            return false;
+        }
+        for (int id = 1; id <= this->job_count; id++) {
+            if ((*offsets)[id] < (*offsets)[id - 1]) {
+                return false;
+            }
+        }
+    }
 
-        auto temp = current_line.substr(0, comma_position);
-        this->jobs.emplace(i, Job{i, std::stoi(current_line.substr(0, comma_position))});
+    std::vector<int> arcs_into(this->job_count, 0);
+    for (int id = 1; id <= this->job_count; id++) {
+        for (int dependent : this->getDependents(id)) {
+            if (dependent < 1 || dependent > this->job_count || dependent == id) {
+                return false;
+            }
+            arcs_into[dependent - 1]++;
+        }
+
+        for (int dependency : this->getDependencies(id)) {
+            if (dependency < 1 || dependency > this->job_count || dependency == id) {
+                return false;
+            }
+        }
+    }
 
-        current_line = current_line.substr(comma_position + 1);
+    for (int id = 1; id <= this->job_count; id++) {
+        if (arcs_into[id - 1] != this->getDependencies(id).size()) {
+            return false;
+        }
     }
 
-    // // handle last value
-    this->jobs.emplace(job_amount, Job{job_amount, std::stoi(current_line)});
+    return this->topologicalOrder().size() == this->job_count;
+}
 
-    // Parse next lines ("[number],[number],[number]") until "Sij="
-    std::getline(file_reader, current_line);  // should be "A=", which cointains no useful information
+void DependencyGraph::computeContentHash() {
+    std::uint64_t hash = 0xcbf29ce484222325;
+    auto hash_values = [&](std::span<const int> values) {
+        for (auto byte : std::as_bytes(values)) {
+            hash ^= static_cast<std::uint64_t>(byte);
+            hash *= 0x100000001b3;
+        }
+    };
+
+    hash_values(std::span{&this->job_count, 1});
+    hash_values(this->processing_time);
+    hash_values(this->dependents_offset);
+    hash_values(this->dependents);
+    hash_values(this->dependent_delays);
+
+    // as ints whatever the stored width, so the hash doesn't depend on it
+    this->sequence_setup_time.visit([&](const auto* values) {
+        for (int i = 0; i < this->job_count * this->job_count; i++) {
+            int value = values[i];
+            hash_values(std::span{&value, 1});
+        }
+    });
 
-    std::getline(file_reader, current_line);
-    while (!current_line.contains("Sij=")) {
-        auto first_comma_position = current_line.find(",");
+    this->content_hash = hash;
+}
 
-        int depended_on = std::stoi(current_line.substr(0, first_comma_position));
-        current_line = current_line.substr(first_comma_position + 1);
+// Kahn's algorithm, leaving out the jobs on or behind a cycle
+std::vector<int> DependencyGraph::topologicalOrder() const {
+    std::vector<int> topological_order;
+    topological_order.reserve(this->job_count);
 
-        auto second_comma_position = current_line.find(",");
-        int dependent = std::stoi(current_line.substr(0, second_comma_position));
-        int precedence_delay = std::stoi(current_line.substr(second_comma_position + 1));
+    std::vector<int> remaining_dependencies(this->job_count);
+    for (int id = 1; id <= this->job_count; id++) {
+        remaining_dependencies[id - 1] = this->getDependencies(id).size();
 
-        jobs.at(depended_on).addDependent(dependent);
-        jobs.at(dependent).addDependency(depended_on);
-        this->precedence_delay[depended_on - 1][dependent - 1] = precedence_delay;
-        this->precedence_delay[dependent - 1][depended_on - 1] = -2;
+        if (remaining_dependencies[id - 1] == 0) {
+            topological_order.push_back(id);
+        }
+    }
 
-        std::getline(file_reader, current_line);
+    for (int i = 0; i < topological_order.size(); i++) {
+        for (int dependent : this->getDependents(topological_order[i])) {
+            if (--remaining_dependencies[dependent - 1] == 0) {
+                topological_order.push_back(dependent);
+            }
+        }
     }
 
-    // Parse next lines ("[number],[number],[number],...") until the end of the file
-    // // no need to ignore "Sij=" since that will already have been read by the previous section
-    while (std::getline(file_reader, current_line)) {
-        std::vector<int> sequence_setup_time;
+    return topological_order;
+}
 
-        for (int i = 1; i < job_amount; i++) {  // last value is handled separately
-            auto comma_position = current_line.find(",");
+void DependencyGraph::computeCascadedDependentsDelay() {
+    // the order is walked backwards so every dependent is done before its job
+    auto topological_order = this->topologicalOrder();
+    if (topological_order.size() != this->job_count) {
+        throw std::invalid_argument{"Precedence arcs contain a cycle.\n"};
+    }
 
-            std::string setup_time = current_line.substr(0, comma_position);
-            sequence_setup_time.push_back(std::stoi(setup_time));
+    this->cascaded_dependents_delay.assign(this->job_count, 0);
+    for (auto iterator = topological_order.crbegin(); iterator != topological_order.crend(); iterator++) {
+        int id = *iterator;
 
-            current_line = current_line.substr(comma_position + 1);
+        int cost = 0;
+        auto dependents = this->getDependents(id);
+        auto delays = this->getDependentDelays(id);
+        for (int k = 0; k < dependents.size(); k++) {
+            cost += delays[k];
+            cost += this->cascaded_dependents_delay[dependents[k] - 1];
         }
-        sequence_setup_time.push_back(std::stoi(current_line));
 
-        this->sequence_setup_time.push_back(sequence_setup_time);
+        this->cascaded_dependents_delay[id - 1] = cost;
     }
+}
+
+void DependencyGraph::computeMeanSetupTime() {
+    this->mean_setup_time.resize(this->job_count);
+
+    this->sequence_setup_time.visit([&](const auto* values) {
+        for (int i = 0; i < this->job_count; i++) {
+            int sum = 0;
+            for (int j = 0; j < this->job_count; j++) {
+                if (i != j) {
+                    sum += values[i * this->job_count + j];
+                }
+            }
+
+            this->mean_setup_time[i] = this->job_count > 1 ? (float) sum / (float) (this->job_count - 1) : 0;
+        }
+    });
+}
+
+int DependencyGraph::getJobCount() const {
+    return this->job_count;
+}
+
+std::span<const int> DependencyGraph::getProcessingTimes() const {
+    return this->processing_time;
+}
+
+std::span<const int> DependencyGraph::getDependents(int id) const {
+    return std::span{this->dependents}.subspan(
+        this->dependents_offset[id - 1],
+        this->dependents_offset[id] - this->dependents_offset[id - 1]
+    );
+}
 
-    file_reader.close();
+std::span<const int> DependencyGraph::getDependencies(int id) const {
+    return std::span{this->dependencies}.subspan(
+        this->dependencies_offset[id - 1],
+        this->dependencies_offset[id] - this->dependencies_offset[id - 1]
+    );
 }
 
-const std::map<int, Job>& DependencyGraph::getJobs() const {
-    return this->jobs;
+std::span<const int> DependencyGraph::getDependentDelays(int id) const {
+    return std::span{this->dependent_delays}.subspan(
+        this->dependents_offset[id - 1],
+        this->dependents_offset[id] - this->dependents_offset[id - 1]
+    );
 }
 
-const std::vector<std::vector<int>>& DependencyGraph::getPrecedenceDelay() const {
-    return this->precedence_delay;
+std::span<const int> DependencyGraph::getDependencyDelays(int id) const {
+    return std::span{this->dependency_delays}.subspan(
+        this->dependencies_offset[id - 1],
+        this->dependencies_offset[id] - this->dependencies_offset[id - 1]
+    );
 }
 
-const std::vector<std::vector<int>>& DependencyGraph::getSequenceSetupTime() const {
+const SetupMatrix& DependencyGraph::getSequenceSetupTime() const {
     return this->sequence_setup_time;
 }
 
+std::span<const int> DependencyGraph::getCascadedDependentsDelay() const {
+    return this->cascaded_dependents_delay;
+}
+
+std::span<const float> DependencyGraph::getMeanSetupTime() const {
+    return this->mean_setup_time;
+}
+
+std::uint64_t DependencyGraph::getContentHash() const {
+    return this->content_hash;
+}
+
+std::size_t DependencyGraph::getByteSize() const {
+    std::size_t ints = this->processing_time.size() + this->dependents_offset.size() + this->dependents.size()
+                     + this->dependent_delays.size() + this->dependencies_offset.size() + this->dependencies.size()
+                     + this->dependency_delays.size() + this->cascaded_dependents_delay.size();
+
+    return ints * sizeof(int) + this->mean_setup_time.size() * sizeof(float) + this->sequence_setup_time.getBytes().size();
+}
+
 void DependencyGraph::exportGraph(std::filesystem::path output_file_path) const {
     std::ofstream file_writer{output_file_path};
 
-    file_writer << "R=" << this->jobs.size() << "\n";
+    file_writer << "R=" << this->job_count << "\n";
 
     file_writer << "Pi=(";
-    file_writer << this->jobs.cbegin()->second.getProcessingTime();
-    for (auto iterator = std::next(this->jobs.cbegin(), 1); iterator != this->jobs.end(); iterator++) {
-        file_writer << "," << iterator->second.getProcessingTime();
+    file_writer << this->processing_time[0];
+    for (int i = 1; i < this->job_count; i++) {
+        file_writer << "," << this->processing_time[i];
     }
     file_writer << ")" << "\n";
 
     file_writer << "A=" << "\n";
-    for (auto [id, job] : this->jobs) {
-        if (job.getDependents().empty()) {
-            continue;
-        }
-
-        for (auto dependent : job.getDependents()) {
-            file_writer << id << "," << dependent << "," << this->precedence_delay[id - 1][dependent - 1] << "\n";
+    for (int id = 1; id <= this->job_count; id++) {
+        auto dependents = this->getDependents(id);
+        auto delays = this->getDependentDelays(id);
+        for (int k = 0; k < dependents.size(); k++) {
+            file_writer << id << "," << dependents[k] << "," << delays[k] << "\n";
         }
     }
 
     file_writer << "Sij=" << "\n";
-    for (auto setup_time : this->sequence_setup_time) {
-        file_writer << *setup_time.cbegin();
-        for (auto iterator = std::next(setup_time.cbegin(), 1); iterator != setup_time.cend(); iterator++) {
-            file_writer << "," << *iterator;
+    for (int from = 1; from <= this->job_count; from++) {
+        file_writer << this->sequence_setup_time(from, 1);
+        for (int to = 2; to <= this->job_count; to++) {
+            file_writer << "," << this->sequence_setup_time(from, to);
         }
         file_writer << "\n";
     }
@@ -0,0 +1,87 @@
+#include "elite_pool.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "schedule_evaluator.hpp"
+
+ElitePool::ElitePool(int capacity, int min_distance): capacity{capacity}, min_distance{min_distance} {
+    this->members.reserve(capacity);
+}
+
+bool ElitePool::offer(const std::vector<int>& schedule, int timespan, bool valid) {
+    if (this->capacity <= 0) {
+        return false;
+    }
+
+    ScheduleEvaluator::Evaluation candidate{timespan, valid};
+    bool crowding = false;
+    int closest_worse = -1;
+    int closest_worse_distance = std::numeric_limits<int>::max();
+    for (int i = 0; i < this->members.size(); i++) {
+        const auto& member = this->members[i];
+        int distance = ElitePool::distance(schedule, member.schedule);
+        bool better = isBetter(candidate, member);
+
+        // a copy of a member is never better than it, so it never gets in
+        if (distance < this->min_distance) {
+            if (!better) {
+                return false;
+            }
+
+            crowding = true;
+        }
+
+        if (better && distance < closest_worse_distance) {
+            closest_worse = i;
+            closest_worse_distance = distance;
+        }
+    }
+
+    // every member it crowds is worse, and all of them go, so the pool stays min_distance apart
+    if (crowding) {
+        std::erase_if(this->members, [&](const Member& member) {
+            return ElitePool::distance(schedule, member.schedule) < this->min_distance;
+        });
+        this->members.push_back({schedule, timespan, valid});
+
+        return true;
+    }
+
+    if (this->members.size() < this->capacity) {
+        this->members.push_back({schedule, timespan, valid});
+
+        return true;
+    }
+
+    if (closest_worse == -1) {
+        return false;
+    }
+
+    this->members[closest_worse] = {schedule, timespan, valid};
+
+    return true;
+}
+
+bool ElitePool::empty() const {
+    return this->members.empty();
+}
+
+int ElitePool::size() const {
+    return this->members.size();
+}
+
+const ElitePool::Member& ElitePool::get(int index) const {
+    return this->members[index];
+}
+
+int ElitePool::distance(std::span<const int> first, std::span<const int> second) {
+    int distance = 0;
+    for (int i = 0; i < first.size(); i++) {
+        if (first[i] != second[i]) {
+            distance++;
+        }
+    }
+
+    return distance;
+}
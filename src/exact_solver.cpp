@@ -0,0 +1,408 @@
+#include "exact_solver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "best_solution.hpp"
+#include "lower_bound.hpp"
+#include "schedule_evaluator.hpp"
+#include "thread_pool.hpp"
+
+// Two prefixes with the same job set and the same last job have the same future. The one that cost
+// less and has waited at least as long on every arc still open (capped at the arc's delay, past
+// which waiting no longer matters) can finish every way the other can, only shorter, so the other
+// is pruned. Entries live in a per-thread table that is dropped whenever it grows too big.
+struct PrefixKey {
+    std::uint64_t placed;
+    int last;
+
+    bool operator==(const PrefixKey&) const = default;
+};
+
+struct PrefixKeyHash {
+    std::size_t operator()(const PrefixKey& key) const {
+        return std::hash<std::uint64_t>{}(key.placed * 0x9E3779B97F4A7C15 + key.last);
+    }
+};
+
+constexpr std::size_t max_dominance_values = std::size_t{1} << 22;
+
+class BranchAndBound {
+    public:
+        BranchAndBound(
+            const DependencyGraph& dependency_graph, int instance_lower_bound, BestSolution& best_solution,
+            std::atomic<bool>& stopped, std::chrono::steady_clock::time_point deadline, bool time_limited
+        );
+
+        // every job with all of its dependencies placed, whose delays have also run out by now
+        void collectEligible(std::vector<int>& eligible) const;
+
+        void place(int job);
+        void remove();
+
+        // explores every completion of the current prefix
+        void search();
+
+        int getLowerBound() const;
+        const std::vector<int>& getPrefix() const;
+        long long getNodesExplored() const;
+
+    private:
+        int job_count;
+        std::span<const int> processing_time;
+        const SetupMatrix& sequence_setup_time;
+        const DependencyGraph& dependency_graph;
+        int instance_lower_bound;
+
+        BestSolution& best_solution;
+        std::atomic<bool>& stopped;
+        std::chrono::steady_clock::time_point deadline;
+        bool time_limited;
+
+        std::vector<int> prefix;
+        std::vector<int> finish_time;  // by job, only meaningful for placed ones
+        std::vector<int> cost_stack;   // timespan of every prefix length, first job counted twice
+        std::uint64_t placed;
+        int remaining_processing_time;
+
+        std::unordered_map<PrefixKey, std::vector<int>, PrefixKeyHash> dominance;
+        std::size_t dominance_values;
+        std::vector<int> open_arc_progress;
+
+        long long nodes_explored;
+
+        int setupTime(int from, int to) const;
+        int elapsedTime() const;
+        bool dominated();
+};
+
+BranchAndBound::BranchAndBound(
+    const DependencyGraph& dependency_graph, int instance_lower_bound, BestSolution& best_solution,
+    std::atomic<bool>& stopped, std::chrono::steady_clock::time_point deadline, bool time_limited
+):
+    job_count{dependency_graph.getJobCount()},
+    processing_time{dependency_graph.getProcessingTimes()},
+    sequence_setup_time{dependency_graph.getSequenceSetupTime()},
+    dependency_graph{dependency_graph},
+    instance_lower_bound{instance_lower_bound},
+    best_solution{best_solution},
+    stopped{stopped},
+    deadline{deadline},
+    time_limited{time_limited},
+    finish_time(dependency_graph.getJobCount(), 0),
+    placed{0},
+    dominance_values{0},
+    nodes_explored{0} {
+    this->remaining_processing_time = 0;
+    for (int id = 1; id <= this->job_count; id++) {
+        this->remaining_processing_time += this->processing_time[id - 1];
+    }
+
+    this->prefix.reserve(this->job_count);
+    this->cost_stack.reserve(this->job_count);
+}
+
+int BranchAndBound::setupTime(int from, int to) const {
+    return this->sequence_setup_time(from, to);
+}
+
+int BranchAndBound::elapsedTime() const {
+    return this->prefix.empty() ? 0 : this->finish_time[this->prefix.back() - 1];
+}
+
+void BranchAndBound::collectEligible(std::vector<int>& eligible) const {
+    eligible.clear();
+
+    int elapsed_time = this->elapsedTime();
+    for (int id = 1; id <= this->job_count; id++) {
+        if (this->placed & (std::uint64_t{1} << (id - 1))) {
+            continue;
+        }
+
+        bool ready = true;
+        auto dependencies = this->dependency_graph.getDependencies(id);
+        auto delays = this->dependency_graph.getDependencyDelays(id);
+        for (int k = 0; k < dependencies.size(); k++) {
+            int dependency = dependencies[k];
+            if (!(this->placed & (std::uint64_t{1} << (dependency - 1))) ||
+                elapsed_time - this->finish_time[dependency - 1] < delays[k]) {
+                ready = false;
+                break;
+            }
+        }
+
+        if (ready) {
+            eligible.push_back(id);
+        }
+    }
+
+    // cheapest setup first, so good schedules turn up early and tighten the pruning
+    int last = this->prefix.empty() ? 0 : this->prefix.back();
+    std::sort(eligible.begin(), eligible.end(), [&](int first, int second) {
+        if (last == 0) {
+            return this->processing_time[first - 1] < this->processing_time[second - 1];
+        }
+
+        return this->setupTime(last, first) < this->setupTime(last, second);
+    });
+}
+
+void BranchAndBound::place(int job) {
+    int cost;
+    if (this->prefix.empty()) {
+        cost = 2 * this->processing_time[job - 1];
+        this->finish_time[job - 1] = this->processing_time[job - 1];
+    } else {
+        int setup = this->setupTime(this->prefix.back(), job);
+        cost = this->cost_stack.back() + setup + this->processing_time[job - 1];
+        this->finish_time[job - 1] = this->elapsedTime() + setup + this->processing_time[job - 1];
+    }
+
+    this->prefix.push_back(job);
+    this->cost_stack.push_back(cost);
+    this->placed |= std::uint64_t{1} << (job - 1);
+    this->remaining_processing_time -= this->processing_time[job - 1];
+}
+
+void BranchAndBound::remove() {
+    int job = this->prefix.back();
+
+    this->prefix.pop_back();
+    this->cost_stack.pop_back();
+    this->placed &= ~(std::uint64_t{1} << (job - 1));
+    this->remaining_processing_time += this->processing_time[job - 1];
+}
+
+// Every unplaced job still needs a setup into it from the last job or another unplaced one, and
+// every one of those but the final job a setup out of it, so either sum of cheapest setups bounds
+// what the setups left can cost. The instance's own bound holds for every prefix too, and once the
+// incumbent reaches it every node is pruned.
+int BranchAndBound::getLowerBound() const {
+    int cost = this->cost_stack.empty() ? 0 : this->cost_stack.back();
+    int last = this->prefix.empty() ? 0 : this->prefix.back();
+
+    // before the first job is placed, one unplaced job goes without an incoming setup too
+    int incoming_bound = 0;
+    int highest_incoming = 0;
+    int outgoing_bound = 0;
+    int highest_outgoing = 0;
+    for (int to = 1; to <= this->job_count; to++) {
+        if (this->placed & (std::uint64_t{1} << (to - 1))) {
+            continue;
+        }
+
+        int cheapest_incoming = last == 0 ? std::numeric_limits<int>::max() : this->setupTime(last, to);
+        int cheapest_outgoing = std::numeric_limits<int>::max();
+        for (int other = 1; other <= this->job_count; other++) {
+            if (other == to || (this->placed & (std::uint64_t{1} << (other - 1)))) {
+                continue;
+            }
+
+            cheapest_incoming = std::min(cheapest_incoming, this->setupTime(other, to));
+            cheapest_outgoing = std::min(cheapest_outgoing, this->setupTime(to, other));
+        }
+
+        if (cheapest_incoming != std::numeric_limits<int>::max()) {
+            incoming_bound += cheapest_incoming;
+            highest_incoming = std::max(highest_incoming, cheapest_incoming);
+        }
+        if (cheapest_outgoing != std::numeric_limits<int>::max()) {
+            outgoing_bound += cheapest_outgoing;
+            highest_outgoing = std::max(highest_outgoing, cheapest_outgoing);
+        }
+    }
+
+    if (last != 0 && this->remaining_processing_time > 0) {
+        int cheapest_outgoing = std::numeric_limits<int>::max();
+        for (int to = 1; to <= this->job_count; to++) {
+            if (!(this->placed & (std::uint64_t{1} << (to - 1)))) {
+                cheapest_outgoing = std::min(cheapest_outgoing, this->setupTime(last, to));
+            }
+        }
+
+        outgoing_bound += cheapest_outgoing;
+        highest_outgoing = std::max(highest_outgoing, cheapest_outgoing);
+    }
+    outgoing_bound -= highest_outgoing;
+    if (last == 0) {
+        incoming_bound -= highest_incoming;
+    }
+
+    return std::max(cost + this->remaining_processing_time + std::max(incoming_bound, outgoing_bound), this->instance_lower_bound);
+}
+
+bool BranchAndBound::dominated() {
+    int elapsed_time = this->elapsedTime();
+
+    this->open_arc_progress.clear();
+    this->open_arc_progress.push_back(this->cost_stack.back());
+
+    // by job id rather than prefix order, so the same place in two entries under one key always
+    // holds the same arc
+    for (int job = 1; job <= this->job_count; job++) {
+        if (!(this->placed & (std::uint64_t{1} << (job - 1)))) {
+            continue;
+        }
+
+        auto dependents = this->dependency_graph.getDependents(job);
+        auto delays = this->dependency_graph.getDependentDelays(job);
+        for (int k = 0; k < dependents.size(); k++) {
+            if (!(this->placed & (std::uint64_t{1} << (dependents[k] - 1)))) {
+                this->open_arc_progress.push_back(std::min(elapsed_time - this->finish_time[job - 1], delays[k]));
+            }
+        }
+    }
+
+    auto& entries = this->dominance[PrefixKey{this->placed, this->prefix.back()}];
+    int entry_size = this->open_arc_progress.size();
+    for (int entry = 0; entry < entries.size(); entry += entry_size) {
+        bool dominates = entries[entry] <= this->open_arc_progress[0];
+        for (int k = 1; k < entry_size && dominates; k++) {
+            dominates = entries[entry + k] >= this->open_arc_progress[k];
+        }
+
+        if (dominates) {
+            return true;
+        }
+    }
+
+    if (this->dominance_values + entry_size > max_dominance_values) {
+        this->dominance.clear();
+        this->dominance_values = 0;
+    }
+
+    auto& kept_entries = this->dominance[PrefixKey{this->placed, this->prefix.back()}];
+    kept_entries.insert(kept_entries.end(), this->open_arc_progress.cbegin(), this->open_arc_progress.cend());
+    this->dominance_values += entry_size;
+
+    return false;
+}
+
+void BranchAndBound::search() {
+    if (this->stopped.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    this->nodes_explored++;
+    if (this->time_limited && this->nodes_explored % 1024 == 0 && std::chrono::steady_clock::now() >= this->deadline) {
+        this->stopped.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    if (this->prefix.size() == this->job_count) {
+        this->best_solution.offer(this->prefix, this->cost_stack.back(), true, 0);
+        return;
+    }
+
+    int incumbent = this->best_solution.empty() ? std::numeric_limits<int>::max() : this->best_solution.getTimespan();
+    if (this->getLowerBound() >= incumbent || (!this->prefix.empty() && this->dominated())) {
+        return;
+    }
+
+    // a dead end when every job left still waits on a delay, since the machine can't idle
+    std::vector<int> eligible;
+    this->collectEligible(eligible);
+
+    for (int job : eligible) {
+        this->place(job);
+        this->search();
+        this->remove();
+    }
+}
+
+const std::vector<int>& BranchAndBound::getPrefix() const {
+    return this->prefix;
+}
+
+long long BranchAndBound::getNodesExplored() const {
+    return this->nodes_explored;
+}
+
+// every feasible prefix of the given length, or complete schedule when the instance is shorter
+void collectPrefixes(BranchAndBound& branch_and_bound, int job_count, int depth, std::vector<std::pair<int, std::vector<int>>>& prefixes) {
+    if (depth == 0 || branch_and_bound.getPrefix().size() == job_count) {
+        prefixes.push_back({branch_and_bound.getLowerBound(), branch_and_bound.getPrefix()});
+        return;
+    }
+
+    std::vector<int> eligible;
+    branch_and_bound.collectEligible(eligible);
+    for (int job : eligible) {
+        branch_and_bound.place(job);
+        collectPrefixes(branch_and_bound, job_count, depth - 1, prefixes);
+        branch_and_bound.remove();
+    }
+}
+
+ExactSolver::Result ExactSolver::solve(const DependencyGraph& dependency_graph, const Options& options, const std::vector<int>& initial_schedule) {
+    int job_count = dependency_graph.getJobCount();
+    if (job_count > max_job_count) {
+        throw std::invalid_argument{"The exact solver takes at most " + std::to_string(max_job_count) + " jobs.\n"};
+    }
+
+    int lower_bound = LowerBound::compute(dependency_graph).value;
+
+    BestSolution best_solution{job_count};
+    ScheduleEvaluator schedule_evaluator{dependency_graph};
+    auto initial_evaluation = schedule_evaluator.evaluate(initial_schedule);
+    if (initial_evaluation.valid) {
+        best_solution.offer(initial_schedule, initial_evaluation.timespan, true, 0);
+    }
+
+    std::atomic<bool> stopped{false};
+    auto deadline = std::chrono::steady_clock::now() + options.time_limit;
+    bool time_limited = options.time_limit.count() > 0;
+
+    // the subtrees go out best bound first, and a worker that finishes one takes the next
+    std::vector<std::pair<int, std::vector<int>>> prefixes;
+    {
+        BranchAndBound branch_and_bound{dependency_graph, lower_bound, best_solution, stopped, deadline, time_limited};
+        collectPrefixes(branch_and_bound, job_count, std::max(1, options.split_depth), prefixes);
+    }
+    std::stable_sort(prefixes.begin(), prefixes.end(), [](const auto& first, const auto& second) {
+        return first.first < second.first;
+    });
+
+    std::atomic<int> next_prefix{0};
+    std::atomic<long long> nodes_explored{0};
+    {
+        ThreadPool thread_pool{options.threads};
+        for (int worker = 0; worker < options.threads; worker++) {
+            thread_pool.submit([&]() {
+                BranchAndBound branch_and_bound{dependency_graph, lower_bound, best_solution, stopped, deadline, time_limited};
+
+                for (int i = next_prefix.fetch_add(1); i < prefixes.size(); i = next_prefix.fetch_add(1)) {
+                    for (int job : prefixes[i].second) {
+                        branch_and_bound.place(job);
+                    }
+
+                    branch_and_bound.search();
+
+                    for (int k = 0; k < prefixes[i].second.size(); k++) {
+                        branch_and_bound.remove();
+                    }
+                }
+
+                nodes_explored.fetch_add(branch_and_bound.getNodesExplored());
+            });
+        }
+        thread_pool.wait();
+    }
+
+    Result result{{}, 0, false, !stopped.load(), lower_bound, nodes_explored.load()};
+    if (!best_solution.empty()) {
+        result.schedule = best_solution.getSchedule();
+        result.timespan = best_solution.getTimespan();
+        result.valid = true;
+    } else if (!initial_schedule.empty()) {
+        result.schedule = initial_schedule;
+        result.timespan = initial_evaluation.timespan;
+    }
+
+    return result;
+}
@@ -1,155 +1,130 @@
 #include "greedy.hpp"
 
 #include <algorithm>
-#include <iostream>
+#include <bit>
+#include <cstdint>
 #include <random>
-#include <set>
 #include <stdexcept>
 
 #include "dependency_graph.hpp"
+#include "local_search.hpp"
+#include "move_evaluator.hpp"
+#include "schedule_evaluator.hpp"
+#include "stats.hpp"
 
-constexpr float dependent_delay_multiplier = 0.4;
-
-int cascadedDependentsDelay(int id, const DependencyGraph& dependency_graph) {
-    int cost = 0;
-    auto jobs = dependency_graph.getJobs();
-    auto precedence_delay = dependency_graph.getPrecedenceDelay();
-
-    for (int dependent : jobs.at(id).getDependents()) {
-        cost += precedence_delay[id - 1][dependent - 1];
-        cost += cascadedDependentsDelay(dependent, dependency_graph);
-    }
-
-    return cost;
-}
-
-std::vector<std::pair<int, float>> constructInitialCandidateList(const DependencyGraph& dependency_graph) {
-    std::vector<std::pair<int, float>> candidate_list;
-
-    for (const auto& [id, job] : dependency_graph.getJobs()) {
-        if (job.getDependencyCount() != 0) {
-            continue;
-        }
-
-        auto sequence_setup_time = dependency_graph.getSequenceSetupTime()[id - 1];
-
-        int sum = 0;
-        int total_summed = 0;
-        for (int i = 0; i < sequence_setup_time.size(); i++) {
-            if (id == (i + 1)) {  // ids are always 1 value bigger since they start at 1
-                continue;
-            }
-
-            sum += sequence_setup_time[i];
-            total_summed++;
-        }
-
-        int cascaded_dependents_delay = cascadedDependentsDelay(id, dependency_graph);
-        float choice_points = ((job.getProcessingTime() + ((float) sum / (float) total_summed)) / 2
-                              ) -
-                              (cascaded_dependents_delay * dependent_delay_multiplier);
-
-        candidate_list.push_back({id, choice_points});
-    }
-
-    // sort from smallest to biggest
-    std::sort(
-        candidate_list.begin(), candidate_list.end(),
-        [](const std::pair<int, float>& first, const std::pair<int, float>& second) {
-            return first.second < second.second;
-        }
-    );
-
-    return candidate_list;
-}
-
-std::vector<std::pair<int, float>> constructCandidateList(int previous_job, const std::set<int>& not_yet_completed_jobs, const DependencyGraph& dependency_graph, const std::map<int, int>& time_left_on_delay) {
-    std::vector<std::pair<int, float>> candidate_list;
-
-    for (int id : not_yet_completed_jobs) {
-        if (
-            dependency_graph.getJobs().at(id).getDependencyCount() != 0 &&
-            (time_left_on_delay.find(id) == time_left_on_delay.end() || time_left_on_delay.at(id) > 0)
-        ) {
-            continue;
-        }
-
-        // int processing_time = dependency_graph.getJobs().at(id).getProcessingTime();
-        int cascaded_dependents_delay = cascadedDependentsDelay(id, dependency_graph);
-        int sequence_setup = dependency_graph.getSequenceSetupTime()[previous_job - 1][id - 1];
-
-        float choice_points = sequence_setup - ((float) cascaded_dependents_delay * dependent_delay_multiplier);
-
-        candidate_list.push_back({id, choice_points});
-    }
-
-    // sort from smallest to biggest
-    std::sort(
-        candidate_list.begin(), candidate_list.end(),
+// only the first upper_limit + 1 candidates can ever be picked, so they're selected instead of sorting the whole list
+int Greedy::pickCandidate(std::span<std::pair<int, float>> candidate_list, float alpha, std::mt19937& generator) {
+    int upper_limit = static_cast<int>(alpha * (candidate_list.size() - 1));
+    std::nth_element(
+        candidate_list.begin(), candidate_list.begin() + upper_limit, candidate_list.end(),
         [](const std::pair<int, float>& first, const std::pair<int, float>& second) {
             return first.second < second.second;
         }
     );
 
-    return candidate_list;
-}
-
-int pickCandidate(const std::vector<std::pair<int, float>>& candidate_list, float alpha, unsigned int seed) {
-    int upper_limit = static_cast<int>(alpha * (candidate_list.size() - 1));
     std::uniform_int_distribution<> uniform_distribution{0, upper_limit};
-
-    std::mt19937 generator{seed};
     int candidate_index = uniform_distribution(generator);
     return candidate_list[candidate_index].first;
 }
 
 std::vector<int> Greedy::greedyRandomizedAdaptiveProcedure(const DependencyGraph& dependency_graph, float alpha, unsigned int seed) {
+    Stats::ScopedTimer timer{Stats::construction};
+    Stats::add(Stats::constructions);
+
     // this is here mostly to reduce verbosity
-    auto jobs = dependency_graph.getJobs();
-    auto precedence_delay = dependency_graph.getPrecedenceDelay();
-    auto sequence_setup_time = dependency_graph.getSequenceSetupTime();
+    int job_count = dependency_graph.getJobCount();
+    auto processing_time = dependency_graph.getProcessingTimes();
+    const auto& sequence_setup_time = dependency_graph.getSequenceSetupTime();
+    auto cascaded_dependents_delay = dependency_graph.getCascadedDependentsDelay();
+    auto mean_setup_time = dependency_graph.getMeanSetupTime();
+
+    // A job joins the ready set once all of its dependencies are placed and the schedule's elapsed
+    // time has reached its release time (the latest end of a dependency plus that arc's delay).
+    // Jobs with every dependency placed but not yet released wait in a short list of their own.
+    std::vector<int> remaining_dependencies(job_count);
+    std::vector<int> release_time(job_count, 0);
+    std::vector<std::uint64_t> ready((job_count + 63) / 64, 0);
+    std::vector<int> waiting;
+
+    for (int id = 1; id <= job_count; id++) {
+        remaining_dependencies[id - 1] = dependency_graph.getDependencies(id).size();
+
+        if (remaining_dependencies[id - 1] == 0) {
+            ready[(id - 1) / 64] |= std::uint64_t{1} << ((id - 1) % 64);
+        }
+    }
 
     std::vector<int> solution;
-    std::map<int, int> time_left_on_delay;
+    solution.reserve(job_count);
+    std::mt19937 generator{seed};
+    std::vector<std::pair<int, float>> candidate_list;
+    candidate_list.reserve(job_count);
+
+    int elapsed_time = 0;
+    int candidate = 0;
+    while (solution.size() != job_count) {
+        for (int i = 0; i < waiting.size();) {
+            int id = waiting[i];
+
+            if (release_time[id - 1] <= elapsed_time) {
+                ready[(id - 1) / 64] |= std::uint64_t{1} << ((id - 1) % 64);
+                waiting[i] = waiting.back();
+                waiting.pop_back();
+            } else {
+                i++;
+            }
+        }
 
-    std::set<int> not_yet_completed_jobs;
-    for (const auto& [id, _] : jobs) {
-        not_yet_completed_jobs.insert(id);
-    }
+        candidate_list.clear();
+        for (int word = 0; word < ready.size(); word++) {
+            for (auto bits = ready[word]; bits != 0; bits &= bits - 1) {
+                int id = word * 64 + std::countr_zero(bits) + 1;
+
+                float choice_points;
+                if (candidate == 0) {
+                    choice_points = ((processing_time[id - 1] + mean_setup_time[id - 1]) / 2) - (cascaded_dependents_delay[id - 1] * Greedy::dependent_delay_multiplier);
+                } else {
+                    int sequence_setup = sequence_setup_time(candidate, id);
+                    choice_points = sequence_setup - ((float) cascaded_dependents_delay[id - 1] * Greedy::dependent_delay_multiplier);
+                }
 
-    auto candidate_list = constructInitialCandidateList(dependency_graph);
-    int candidate = pickCandidate(candidate_list, alpha, seed);
+                candidate_list.push_back({id, choice_points});
+            }
+        }
 
-    solution.push_back(candidate);
-    not_yet_completed_jobs.erase(candidate);
+        // when every remaining job is still waiting on a precedence delay the delays are relaxed,
+        // otherwise the construction would have no job to pick from
+        if (candidate_list.empty()) {
+            Stats::add(Stats::delay_relaxations);
 
-    for (auto dependent : jobs.at(candidate).getDependents()) {
-        time_left_on_delay.emplace(
-            dependent,
-            precedence_delay[candidate - 1][dependent - 1]
-        );
-    }
+            for (int id : waiting) {
+                int sequence_setup = sequence_setup_time(candidate, id);
+                candidate_list.push_back({id, sequence_setup - ((float) cascaded_dependents_delay[id - 1] * Greedy::dependent_delay_multiplier)});
+            }
+        }
 
-    while (!not_yet_completed_jobs.empty()) {
-        candidate_list = constructCandidateList(candidate, not_yet_completed_jobs, dependency_graph, time_left_on_delay);
-        int new_candidate = pickCandidate(candidate_list, alpha, seed);
-        time_left_on_delay.erase(new_candidate);
+        int new_candidate = Greedy::pickCandidate(candidate_list, alpha, generator);
 
-        for (auto& value : time_left_on_delay) {
-            int time_to_remove = sequence_setup_time[candidate - 1][new_candidate - 1] + jobs.at(new_candidate).getProcessingTime();
-            value.second -= time_to_remove;
+        if (ready[(new_candidate - 1) / 64] & (std::uint64_t{1} << ((new_candidate - 1) % 64))) {
+            ready[(new_candidate - 1) / 64] &= ~(std::uint64_t{1} << ((new_candidate - 1) % 64));
+        } else {
+            std::erase(waiting, new_candidate);
         }
 
-        for (auto dependent : jobs.at(new_candidate).getDependents()) {
-            time_left_on_delay.emplace(
-                dependent,
-                precedence_delay[new_candidate - 1][dependent - 1]
-            );
+        elapsed_time += (candidate == 0 ? 0 : sequence_setup_time(candidate, new_candidate)) + processing_time[new_candidate - 1];
+
+        auto dependents = dependency_graph.getDependents(new_candidate);
+        auto dependent_delays = dependency_graph.getDependentDelays(new_candidate);
+        for (int k = 0; k < dependents.size(); k++) {
+            int dependent = dependents[k];
+            release_time[dependent - 1] = std::max(release_time[dependent - 1], elapsed_time + dependent_delays[k]);
+
+            if (--remaining_dependencies[dependent - 1] == 0) {
+                waiting.push_back(dependent);
+            }
         }
 
         solution.push_back(new_candidate);
-        not_yet_completed_jobs.erase(new_candidate);
-
         candidate = new_candidate;
     }
 
@@ -161,14 +136,17 @@ int Greedy::calculateTimespan(const DependencyGraph& dependency_graph, const std
         throw std::invalid_argument("Empty schedule!\n");
     }
 
+    auto processing_time = dependency_graph.getProcessingTimes();
+    const auto& sequence_setup_time = dependency_graph.getSequenceSetupTime();
+
     int timespan = 0;
 
     int previous_job = schedule[0];
-    timespan += dependency_graph.getJobs().at(previous_job).getProcessingTime();
+    timespan += processing_time[previous_job - 1];
 
     for (auto job : schedule) {
-        timespan += dependency_graph.getJobs().at(job).getProcessingTime();
-        timespan += dependency_graph.getSequenceSetupTime()[previous_job - 1][job - 1];
+        timespan += processing_time[job - 1];
+        timespan += sequence_setup_time(previous_job, job);
 
         previous_job = job;
     }
@@ -176,156 +154,26 @@ int Greedy::calculateTimespan(const DependencyGraph& dependency_graph, const std
     return timespan;
 }
 
+// one-off check, anything that validates in a loop should keep a ScheduleEvaluator of its own
 bool Greedy::checkScheduleValidity(const DependencyGraph& dependency_graph, const std::vector<int>& schedule) {
     if (schedule.size() == 0) {
         throw std::invalid_argument("Empty schedule!\n");
     }
 
-    // this is here mostly to reduce verbosity
-    auto jobs = dependency_graph.getJobs();
-    auto precedence_delay = dependency_graph.getPrecedenceDelay();
-    auto sequence_setup_time = dependency_graph.getSequenceSetupTime();
-
-    std::map<int, int> time_left_on_delay;
-    std::set<int> can_be_added;
-    for (const auto [id, job] : dependency_graph.getJobs()) {
-        if (job.getDependencyCount() == 0) {
-            can_be_added.insert(id);
-        }
-    }
-
-    int previous_id = schedule[0];
-    can_be_added.erase(previous_id);
-    for (auto dependent_id : dependency_graph.getJobs().at(previous_id).getDependents()) {
-        time_left_on_delay.emplace(dependent_id, dependency_graph.getPrecedenceDelay()[previous_id][dependent_id]);
-    }
-
-    for (auto id_iterator = std::next(schedule.cbegin(), 1); id_iterator != schedule.cend(); id_iterator++) {
-        int id = *id_iterator;
-
-        if (!can_be_added.contains(id)) {
-            return false;
-        }
-
-        can_be_added.erase(id);
-
-        // can't remove during loop, otherwise the loop will break
-        std::vector<int> list_to_move;
-        for (auto& value : time_left_on_delay) {
-            int time_to_remove = sequence_setup_time[previous_id - 1][id - 1] + jobs.at(id).getProcessingTime();
-            value.second -= time_to_remove;
-
-            if (value.second <= 0) {
-                list_to_move.push_back(value.first);
-            }
-        }
-
-        for (auto value : list_to_move) {
-            time_left_on_delay.erase(value);
-            can_be_added.insert(value);
-        }
-
-        for (auto dependent_id : dependency_graph.getJobs().at(id).getDependents()) {
-            if (precedence_delay[id - 1][dependent_id - 1] <= 0) {
-                can_be_added.insert(dependent_id);
-            } else {
-                time_left_on_delay.emplace(dependent_id, dependency_graph.getPrecedenceDelay()[id - 1][dependent_id - 1]);
-            }
-        }
-
-        previous_id = id;
-    }
-
-    if (can_be_added.size() != 0) {
-        return false;
-    }
-
-    return true;
+    return ScheduleEvaluator{dependency_graph}.evaluate(schedule).valid;
 }
 
 std::vector<int> Greedy::localSearch(const DependencyGraph& dependency_graph, float alpha, unsigned int seed) {
-    auto best_result = Greedy::greedyRandomizedAdaptiveProcedure(dependency_graph, alpha, seed);
-    auto best_timespan = Greedy::calculateTimespan(dependency_graph, best_result);
-
-    // swaps two indices
-    {
-        bool improved = true;
-        constexpr int max_iterations = 500;
-        int iterations = 0;
-        while (improved && iterations < max_iterations) {
-            improved = false;
-
-            int previous_best_timespan;
-            for (int i = 0; i < best_result.size(); i++) {
-                for (int j = 0; j < best_result.size(); j++) {
-                    if (i == j) {
-                        continue;
-                    }
-
-                    auto result = best_result;
-                    std::swap(result[i], result[j]);
-                    if (Greedy::checkScheduleValidity(dependency_graph, result)) {
-                        auto timespan = Greedy::calculateTimespan(dependency_graph, result);
-
-                        if (timespan < best_timespan) {
-                            best_result = result;
-                            best_timespan = timespan;
-
-                            improved = true;
-                            break;
-                        }
-                    }
-                }
+    long long moves_evaluated = 0;
 
-                if (best_timespan < previous_best_timespan) {
-                    break;
-                }
-            }
-
-            iterations++;
-        }
-    }
-
-    // inserts
-    {
-        bool improved = true;
-        constexpr int max_iterations = 500;
-        int iterations = 0;
-        while (improved && iterations < max_iterations) {
-            improved = false;
-
-            int previous_best_timespan;
-            for (int i = 0; i < best_result.size(); i++) {
-                for (int j = 0; j < best_result.size(); j++) {
-                    if (i == j) {
-                        continue;
-                    }
-
-                    auto result = best_result;
-                    int value = result[i];
-                    result.erase(result.begin() + i);
-                    result.insert(result.begin() + j, value);
-                    if (Greedy::checkScheduleValidity(dependency_graph, result)) {
-                        auto timespan = Greedy::calculateTimespan(dependency_graph, result);
-
-                        if (timespan < best_timespan) {
-                            best_result = result;
-                            best_timespan = timespan;
-
-                            improved = true;
-                            break;
-                        }
-                    }
-                }
+    return Greedy::localSearch(dependency_graph, Greedy::greedyRandomizedAdaptiveProcedure(dependency_graph, alpha, seed), moves_evaluated);
+}
 
-                if (best_timespan < previous_best_timespan) {
-                    break;
-                }
-            }
+std::vector<int> Greedy::localSearch(const DependencyGraph& dependency_graph, const std::vector<int>& schedule, long long& moves_evaluated) {
+    MoveEvaluator move_evaluator{dependency_graph};
+    move_evaluator.load(schedule);
 
-            iterations++;
-        }
-    }
+    LocalSearch::descend(move_evaluator, LocalSearch::defaultNeighborhoods(), moves_evaluated);
 
-    return best_result;
+    return move_evaluator.getSchedule();
 }
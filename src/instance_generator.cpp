@@ -0,0 +1,116 @@
+#include "instance_generator.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// appends value without the stream machinery, the setup matrix alone is job_count² numbers
+void appendNumber(std::string& text, int value) {
+    char buffer[16];
+    auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    text.append(buffer, end);
+}
+
+int arcCount(const InstanceGenerator::Options& options) {
+    return options.arc_count >= 0 ? options.arc_count : options.job_count / 2;
+}
+
+int zeroDelayArcCount(const InstanceGenerator::Options& options) {
+    return options.zero_delay_arc_count >= 0 ? options.zero_delay_arc_count : arcCount(options) / 2;
+}
+
+std::string InstanceGenerator::generate(const Options& options) {
+    int job_count = options.job_count;
+    int arc_count = arcCount(options);
+    int zero_delay_arc_count = zeroDelayArcCount(options);
+
+    if (job_count < 1) {
+        throw std::invalid_argument{"An instance needs at least one job.\n"};
+    }
+    for (const auto& range : {options.processing_time, options.setup_time, options.delay}) {
+        if (range.min < 0 || range.min >= range.max) {
+            throw std::invalid_argument{"A range a-b needs 0 <= a < b.\n"};
+        }
+    }
+    // every arc leaves a different job, and the last one has no later job to go to
+    if (arc_count > job_count - 1) {
+        throw std::invalid_argument{"At most " + std::to_string(job_count - 1) + " arcs fit " + std::to_string(job_count) + " jobs.\n"};
+    }
+    if (zero_delay_arc_count > arc_count) {
+        throw std::invalid_argument{"More zero-delay arcs than arcs.\n"};
+    }
+
+    std::seed_seq seed_sequence{options.seed, static_cast<unsigned int>(options.instance_number), static_cast<unsigned int>(job_count)};
+    std::mt19937 generator{seed_sequence};
+    auto draw = [&](Range range) {
+        return std::uniform_int_distribution<int>{range.min, range.max - 1}(generator);
+    };
+
+    std::string text;
+    text.reserve(static_cast<std::size_t>(job_count) * job_count * 3 + 64);
+
+    text += "R=";
+    appendNumber(text, job_count);
+    text += "\nPi=(";
+    for (int id = 1; id <= job_count; id++) {
+        if (id > 1) {
+            text += ',';
+        }
+        appendNumber(text, draw(options.processing_time));
+    }
+    text += ")\n";
+
+    // the arcs come out sorted by their "from" job, as in the bundled instances
+    std::vector<int> from_ids(job_count - 1);
+    std::iota(from_ids.begin(), from_ids.end(), 1);
+    std::shuffle(from_ids.begin(), from_ids.end(), generator);
+    from_ids.resize(arc_count);
+    std::sort(from_ids.begin(), from_ids.end());
+
+    std::vector<bool> zero_delay(arc_count, false);
+    std::fill(zero_delay.begin(), zero_delay.begin() + zero_delay_arc_count, true);
+    std::shuffle(zero_delay.begin(), zero_delay.end(), generator);
+
+    text += "A=\n";
+    for (int k = 0; k < arc_count; k++) {
+        int from = from_ids[k];
+        int to = from + std::uniform_int_distribution<int>{1, std::min(5, job_count - from)}(generator);
+
+        appendNumber(text, from);
+        text += ',';
+        appendNumber(text, to);
+        text += ',';
+        appendNumber(text, zero_delay[k] ? 0 : draw(options.delay));
+        text += '\n';
+    }
+
+    text += "Sij=\n";
+    for (int from = 1; from <= job_count; from++) {
+        for (int to = 1; to <= job_count; to++) {
+            if (to > 1) {
+                text += ',';
+            }
+            appendNumber(text, from == to ? 0 : draw(options.setup_time));
+        }
+        text += '\n';
+    }
+
+    return text;
+}
+
+std::string InstanceGenerator::fileName(const Options& options) {
+    auto range = [](Range range) {
+        return "(" + std::to_string(range.min) + "-" + std::to_string(range.max) + ")";
+    };
+
+    return "N" + std::to_string(options.job_count)
+         + "_P" + range(options.processing_time)
+         + "_S" + range(options.setup_time)
+         + "_A" + range(options.delay)
+         + "_W" + std::to_string(arcCount(options))
+         + "_Wo" + std::to_string(zeroDelayArcCount(options))
+         + "_P" + std::to_string(options.instance_number) + ".txt";
+}
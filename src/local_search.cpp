@@ -0,0 +1,223 @@
+#include "local_search.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "stats.hpp"
+
+LocalSearch::Neighborhoods LocalSearch::defaultNeighborhoods() {
+    Neighborhoods neighborhoods;
+    neighborhoods.push_back(std::make_unique<SwapNeighborhood>());
+    neighborhoods.push_back(std::make_unique<InsertNeighborhood>());
+    neighborhoods.push_back(std::make_unique<BlockNeighborhood>());
+    neighborhoods.push_back(std::make_unique<ReversalNeighborhood>());
+
+    return neighborhoods;
+}
+
+LocalSearch::Neighborhoods LocalSearch::granularNeighborhoods(const CandidateLists& candidate_lists) {
+    Neighborhoods neighborhoods;
+    neighborhoods.push_back(std::make_unique<GranularSwapNeighborhood>(candidate_lists));
+    neighborhoods.push_back(std::make_unique<GranularInsertNeighborhood>(candidate_lists));
+    neighborhoods.push_back(std::make_unique<BlockNeighborhood>());
+    neighborhoods.push_back(std::make_unique<ReversalNeighborhood>());
+
+    return neighborhoods;
+}
+
+void LocalSearch::descend(MoveEvaluator& move_evaluator, const Neighborhoods& neighborhoods, long long& moves_evaluated, int max_improvements) {
+    int improvements = 0;
+    for (int k = 0; k < neighborhoods.size() && improvements < max_improvements;) {
+        if (neighborhoods[k]->improve(move_evaluator, moves_evaluated)) {
+            improvements++;
+            k = 0;
+        } else {
+            k++;
+        }
+    }
+}
+
+LocalSearch::ParallelDescent::ParallelDescent(const DependencyGraph& dependency_graph, ThreadPool& thread_pool):
+    thread_pool{thread_pool},
+    slot_count{thread_pool.getThreadCount()},
+    slot_versions(thread_pool.getThreadCount(), -1),
+    slot_deltas(thread_pool.getThreadCount(), std::vector<int>(dependency_graph.getJobCount())),
+    slot_best(thread_pool.getThreadCount()),
+    slot_moves(thread_pool.getThreadCount(), 0),
+    version{0} {
+    this->slot_evaluators.reserve(this->slot_count - 1);
+    for (int slot = 1; slot < this->slot_count; slot++) {
+        this->slot_evaluators.emplace_back(dependency_graph);
+    }
+}
+
+void LocalSearch::ParallelDescent::descend(MoveEvaluator& move_evaluator, const Neighborhoods& neighborhoods, long long& moves_evaluated, int max_improvements) {
+    // the caller may have loaded anything since the last descent
+    this->version++;
+
+    int improvements = 0;
+    for (int k = 0; k < neighborhoods.size() && improvements < max_improvements;) {
+        auto move = this->best(move_evaluator, *neighborhoods[k], moves_evaluated);
+        if (move.found()) {
+            neighborhoods[k]->apply(move_evaluator, move);
+            this->version++;
+
+            improvements++;
+            k = 0;
+        } else {
+            k++;
+        }
+    }
+}
+
+// below about this many moves, waking the pool costs more than the scan it would split
+constexpr int min_parallel_moves = 8192;
+
+Move LocalSearch::ParallelDescent::best(MoveEvaluator& move_evaluator, const Neighborhood& neighborhood, long long& moves_evaluated) {
+    int job_count = move_evaluator.getSchedule().size();
+    int row_count = neighborhood.rowCount(job_count);
+
+    // the best move is the same however the rows are split, so small scans just stay on this thread
+    int active_slots = row_count * job_count >= min_parallel_moves ? this->slot_count : 1;
+
+    // slot s takes rows s, s + active_slots, ..., which spreads the long and short rows evenly
+    auto scan = [&](int slot) {
+        MoveEvaluator& slot_evaluator = slot == 0 ? move_evaluator : this->slot_evaluators[slot - 1];
+        if (slot != 0 && this->slot_versions[slot] != this->version) {
+            slot_evaluator.load(move_evaluator.getSchedule());
+            this->slot_versions[slot] = this->version;
+        }
+
+        Stats::ScopedTimer timer{neighborhood.phase()};
+
+        this->slot_best[slot] = Move{};
+        this->slot_moves[slot] = 0;
+        for (int row = slot; row < row_count; row += active_slots) {
+            neighborhood.scanRow(slot_evaluator, row, this->slot_deltas[slot], this->slot_best[slot], this->slot_moves[slot]);
+        }
+    };
+
+    if (active_slots == 1) {
+        scan(0);
+    } else {
+        this->thread_pool.parallelFor(active_slots, scan);
+    }
+
+    Move best;
+    for (int slot = 0; slot < active_slots; slot++) {
+        best = std::min(best, this->slot_best[slot]);
+        moves_evaluated += this->slot_moves[slot];
+    }
+
+    return best;
+}
+
+bool LocalSearch::relink(MoveEvaluator& move_evaluator, const std::vector<int>& guide, long long& moves_evaluated) {
+    int job_count = guide.size();
+    const auto& schedule = move_evaluator.getSchedule();
+
+    std::vector<int> position(job_count);
+    std::vector<int> mismatched;
+    for (int k = 0; k < job_count; k++) {
+        position[schedule[k] - 1] = k;
+        if (schedule[k] != guide[k]) {
+            mismatched.push_back(k);
+        }
+    }
+
+    std::vector<int> best_schedule;
+    int best_violations = std::numeric_limits<int>::max();
+    int best_timespan = std::numeric_limits<int>::max();
+    while (!mismatched.empty()) {
+        int step = -1;
+        int step_violations = std::numeric_limits<int>::max();
+        int step_delta = std::numeric_limits<int>::max();
+        for (int k = 0; k < mismatched.size(); k++) {
+            int i = mismatched[k];
+            int delta = move_evaluator.swapTimespanDelta(i, position[guide[i] - 1]);
+            moves_evaluated++;
+
+            // the violations are only counted for steps that could still win
+            if (step_violations == 0 && delta >= step_delta) {
+                continue;
+            }
+
+            int violations = move_evaluator.swapViolationCount(i, position[guide[i] - 1]);
+            if (violations < step_violations || (violations == step_violations && delta < step_delta)) {
+                step = k;
+                step_violations = violations;
+                step_delta = delta;
+            }
+        }
+
+        int i = mismatched[step];
+        int j = position[guide[i] - 1];
+        move_evaluator.applySwap(i, j);
+        position[schedule[i] - 1] = i;
+        position[schedule[j] - 1] = j;
+
+        // i holds its job now, and j may have got its own as well
+        mismatched[step] = mismatched.back();
+        mismatched.pop_back();
+        if (schedule[j] == guide[j]) {
+            std::erase(mismatched, j);
+        }
+
+        if (mismatched.empty()) {
+            break;
+        }
+
+        int violations = move_evaluator.getViolationCount();
+        int timespan = move_evaluator.getTimespan();
+        if (violations < best_violations || (violations == best_violations && timespan < best_timespan)) {
+            best_schedule = schedule;
+            best_violations = violations;
+            best_timespan = timespan;
+        }
+    }
+
+    if (best_schedule.empty()) {
+        return false;
+    }
+
+    move_evaluator.load(best_schedule);
+
+    return true;
+}
+
+std::vector<int> LocalSearch::perturb(const DependencyGraph& dependency_graph, const std::vector<int>& schedule, int strength, std::mt19937& generator) {
+    int job_count = dependency_graph.getJobCount();
+    auto perturbed = schedule;
+    std::vector<int> position(job_count);
+
+    std::uniform_int_distribution<> job_distribution{0, job_count - 1};
+    for (int i = 0; i < strength; i++) {
+        int from_position = job_distribution(generator);
+        int job = perturbed[from_position];
+        perturbed.erase(perturbed.begin() + from_position);
+
+        for (int k = 0; k < job_count - 1; k++) {
+            position[perturbed[k] - 1] = k;
+        }
+
+        // positions in the schedule without the job, the job goes right before the given one
+        int lowest_position = 0;
+        int highest_position = job_count - 1;
+        for (int dependency : dependency_graph.getDependencies(job)) {
+            lowest_position = std::max(lowest_position, position[dependency - 1] + 1);
+        }
+        for (int dependent : dependency_graph.getDependents(job)) {
+            highest_position = std::min(highest_position, position[dependent - 1]);
+        }
+
+        // a schedule that already breaks the order leaves no window, the job then stays where it was
+        int to_position = from_position;
+        if (lowest_position <= highest_position) {
+            to_position = std::uniform_int_distribution<>{lowest_position, highest_position}(generator);
+        }
+
+        perturbed.insert(perturbed.begin() + to_position, job);
+    }
+
+    return perturbed;
+}
@@ -0,0 +1,168 @@
+#include "lower_bound.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+constexpr long long forbidden_cost = std::numeric_limits<int>::max();
+
+// Hungarian method with row and column potentials, O(n^3). Node 0 is the start of the schedule,
+// cost(i, j) is what it takes to run j right after i.
+long long solveAssignment(int node_count, auto cost) {
+    // 1-based rows and columns as the method is usually written, column 0 is the sentinel
+    std::vector<long long> row_potential(node_count + 1, 0);
+    std::vector<long long> column_potential(node_count + 1, 0);
+    std::vector<int> column_row(node_count + 1, 0);
+    std::vector<int> column_way(node_count + 1, 0);
+    std::vector<long long> slack(node_count + 1);
+    std::vector<bool> used(node_count + 1);
+
+    for (int row = 1; row <= node_count; row++) {
+        column_row[0] = row;
+        int column = 0;
+        std::fill(slack.begin(), slack.end(), std::numeric_limits<long long>::max());
+        std::fill(used.begin(), used.end(), false);
+
+        do {
+            used[column] = true;
+            int current_row = column_row[column];
+            long long delta = std::numeric_limits<long long>::max();
+            int next_column = 0;
+
+            for (int j = 1; j <= node_count; j++) {
+                if (used[j]) {
+                    continue;
+                }
+
+                long long reduced_cost = cost(current_row - 1, j - 1) - row_potential[current_row] - column_potential[j];
+                if (reduced_cost < slack[j]) {
+                    slack[j] = reduced_cost;
+                    column_way[j] = column;
+                }
+
+                if (slack[j] < delta) {
+                    delta = slack[j];
+                    next_column = j;
+                }
+            }
+
+            for (int j = 0; j <= node_count; j++) {
+                if (used[j]) {
+                    row_potential[column_row[j]] += delta;
+                    column_potential[j] -= delta;
+                } else {
+                    slack[j] -= delta;
+                }
+            }
+
+            column = next_column;
+        } while (column_row[column] != 0);
+
+        do {
+            int previous_column = column_way[column];
+            column_row[column] = column_row[previous_column];
+            column = previous_column;
+        } while (column != 0);
+    }
+
+    long long total = 0;
+    for (int j = 1; j <= node_count; j++) {
+        total += cost(column_row[j] - 1, j - 1);
+    }
+
+    return total;
+}
+
+LowerBound::Bound LowerBound::compute(const DependencyGraph& dependency_graph) {
+    // this is here mostly to reduce verbosity
+    int job_count = dependency_graph.getJobCount();
+    auto processing_time = dependency_graph.getProcessingTimes();
+    const auto& sequence_setup_time = dependency_graph.getSequenceSetupTime();
+
+    int processing_time_sum = 0;
+    int shortest_processing_time = std::numeric_limits<int>::max();
+    for (int id = 1; id <= job_count; id++) {
+        processing_time_sum += processing_time[id - 1];
+        shortest_processing_time = std::min(shortest_processing_time, processing_time[id - 1]);
+    }
+
+    // nodes are 0 for the start of the schedule and the job ids after it, which also closes the path into a cycle
+    auto cost = [&](int from, int to) -> long long {
+        if (from == to) {
+            return forbidden_cost;
+        }
+        if (from == 0) {
+            return processing_time[to - 1];
+        }
+        if (to == 0) {
+            return 0;
+        }
+
+        return sequence_setup_time(from, to);
+    };
+
+    long long assignment;
+    if (job_count <= max_exact_assignment_jobs) {
+        assignment = solveAssignment(job_count + 1, cost);
+    } else {
+        // every node still needs one cheapest predecessor and one cheapest successor
+        long long incoming = 0;
+        long long outgoing = 0;
+        for (int node = 0; node <= job_count; node++) {
+            long long cheapest_incoming = forbidden_cost;
+            long long cheapest_outgoing = forbidden_cost;
+            for (int other = 0; other <= job_count; other++) {
+                cheapest_incoming = std::min(cheapest_incoming, cost(other, node));
+                cheapest_outgoing = std::min(cheapest_outgoing, cost(node, other));
+            }
+
+            incoming += cheapest_incoming;
+            outgoing += cheapest_outgoing;
+        }
+
+        assignment = std::max(incoming, outgoing);
+    }
+
+    // longest path in topological order (Kahn), a cycle leaves its jobs out and only weakens the bound
+    std::vector<int> remaining_dependencies(job_count);
+    std::vector<int> ready;
+    for (int id = 1; id <= job_count; id++) {
+        remaining_dependencies[id - 1] = dependency_graph.getDependencies(id).size();
+        if (remaining_dependencies[id - 1] == 0) {
+            ready.push_back(id);
+        }
+    }
+
+    std::vector<int> earliest_start(job_count, 0);
+    int critical_path = 0;
+    while (!ready.empty()) {
+        int id = ready.back();
+        ready.pop_back();
+
+        int earliest_finish = earliest_start[id - 1] + processing_time[id - 1];
+        critical_path = std::max(critical_path, earliest_finish);
+
+        auto dependents = dependency_graph.getDependents(id);
+        auto delays = dependency_graph.getDependentDelays(id);
+        for (int k = 0; k < dependents.size(); k++) {
+            int dependent = dependents[k];
+            int delay = delays[k];
+            earliest_start[dependent - 1] = std::max(earliest_start[dependent - 1], earliest_finish + delay);
+
+            if (--remaining_dependencies[dependent - 1] == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+
+    Bound bound;
+    bound.setup_assignment = processing_time_sum + static_cast<int>(assignment);
+    bound.critical_path = critical_path + shortest_processing_time;
+    bound.value = std::max(bound.setup_assignment, bound.critical_path);
+
+    return bound;
+}
+
+double LowerBound::gap(int timespan, int bound) {
+    return bound == 0 ? 0 : static_cast<double>(timespan - bound) / bound * 100;
+}
@@ -1,31 +1,180 @@
+#include <unistd.h>
+
 #include <chrono>
 #include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
 #include "dependency_graph.hpp"
+#include "exact_solver.hpp"
 #include "greedy.hpp"
+#include "lower_bound.hpp"
+#include "solve_service.hpp"
+#include "solver.hpp"
+#include "stats.hpp"
+
+void printUsage(const char *program_name) {
+    std::cout << "Usage: " << program_name << " <instance file> [--iterations N] [--threads N] [--seed N] [--alpha X|reactive]\n"
+              << "       [--perturbations N] [--time-limit ms] [--trace file] [--stats[=json]] [--exact]\n"
+              << "       [--elite N] [--tabu N] [--granular K] [--store directory] [--parallel-neighborhoods]\n"
+              << "   or: " << program_name << " --serve [--socket path] [--workers N] [--queue N] [solver options]\n"
+              << "       reading one request per line from stdin or the socket, see solve_service.hpp\n";
+}
 
 int main(int argc, char *argv[]) {
-    if (argc != 2) {
-        std::cout << "Too many parameters were supplied.\n";
+    if (argc < 2) {
+        printUsage(argv[0]);
+
+        return 1;
+    }
+
+    // in service mode the options are every request's defaults
+    bool serve = std::string_view{argv[1]} == "--serve";
+    SolveService::Options service_options;
+    std::filesystem::path socket_path;
+
+    Solver::Options options;
+    bool iterations_given = false;
+    std::string stats_format;
+    bool exact = false;
+    try {
+        for (int i = 2; i < argc; i++) {
+            std::string option{argv[i]};
+
+            // the only options without a value
+            if (option == "--stats" || option == "--stats=text" || option == "--stats=json") {
+                stats_format = option == "--stats=json" ? "json" : "text";
+                continue;
+            }
+
+            if (option == "--exact") {
+                exact = true;
+                continue;
+            }
+
+            if (option == "--parallel-neighborhoods") {
+                options.parallel_neighborhoods = true;
+                continue;
+            }
+
+            if (i + 1 == argc) {
+                throw std::invalid_argument{"Missing value for " + option + ".\n"};
+            }
+            std::string value{argv[++i]};
+
+            if (Solver::parseOption(options, option, value, iterations_given)) {
+                continue;
+            }
+
+            if (serve && option == "--socket") {
+                socket_path = value;
+                continue;
+            }
+            if (serve && option == "--workers") {
+                service_options.workers = std::stoi(value);
+                if (service_options.workers < 1) {
+                    throw std::invalid_argument{"--workers takes at least 1.\n"};
+                }
+                continue;
+            }
+            if (serve && option == "--queue") {
+                service_options.queue_capacity = std::stoi(value);
+                continue;
+            }
+
+            throw std::invalid_argument{"Unknown option " + option + ".\n"};
+        }
+    } catch (const std::exception& exception) {
+        std::cout << exception.what();
+        printUsage(argv[0]);
 
         return 1;
     }
 
+    if (serve) {
+        if (exact || !stats_format.empty()) {
+            std::cout << "--exact and --stats aren't available in service mode.\n";
+
+            return 1;
+        }
+
+        service_options.solver = options;
+        service_options.iterations_given = iterations_given;
+        SolveService service{service_options};
+
+        if (socket_path.empty()) {
+            service.serve(STDIN_FILENO, STDOUT_FILENO);
+        } else {
+            service.listen(socket_path);
+        }
+
+        return 0;
+    }
+
+    // with a time limit the deadline ends the run, unless an iteration count was asked for too; in
+    // exact mode the limit goes to the branch-and-bound and the heuristic only provides its first bound
+    if (!exact) {
+        Solver::applyTimeLimit(options, iterations_given);
+    }
+
     std::filesystem::path instance_file_path{argv[1]};
-    DependencyGraph dependency_graph{instance_file_path};
+    auto dependency_graph = DependencyGraph::load(instance_file_path);
+
+    if (exact && dependency_graph.getJobCount() > ExactSolver::max_job_count) {
+        std::cout << "--exact takes instances of at most " << ExactSolver::max_job_count << " jobs, this one has "
+                  << dependency_graph.getJobCount() << ".\n";
+        printUsage(argv[0]);
+
+        return 1;
+    }
 
     auto start_time = std::chrono::high_resolution_clock::now();
-    auto result = Greedy::localSearch(dependency_graph, 0.3, 3);
+    auto result = Solver::multiStart(dependency_graph, options);
+
+    bool optimal = false;
+    if (exact) {
+        ExactSolver::Options exact_options;
+        exact_options.threads = options.threads;
+        exact_options.time_limit = options.time_limit;
+
+        auto exact_result = ExactSolver::solve(dependency_graph, exact_options, result.schedule);
+        optimal = exact_result.optimal;
+        if (exact_result.valid) {
+            result.schedule = exact_result.schedule;
+            result.timespan = exact_result.timespan;
+            result.valid = true;
+        }
+    }
+
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 
-    int timespan = Greedy::calculateTimespan(dependency_graph, result);
-    std::cout << timespan << " (" << duration.count() << "ms)" << ": ";
-    for (auto value : result) {
+    // a schedule that reached the bound is optimal as well
+    optimal = optimal || (result.valid && result.timespan <= result.lower_bound);
+
+    // the gap is to the instance bound, which a proven optimum can stay above, so it's left out then
+    std::cout << result.timespan << (result.valid ? "" : " (invalid)");
+    if (optimal) {
+        std::cout << " (optimal)";
+    } else {
+        std::cout << " (gap " << std::fixed << std::setprecision(2) << LowerBound::gap(result.timespan, result.lower_bound) << "%)";
+    }
+    std::cout << " (" << duration.count() << "ms)" << ": ";
+    for (auto value : result.schedule) {
         std::cout << value << " ";
     }
     std::cout << "\n";
 
+    // on stderr, so the schedule line stays the only thing on stdout
+    if (stats_format == "json") {
+        Stats::printJson(std::cerr, Stats::collect());
+    } else if (stats_format == "text") {
+        Stats::print(std::cerr, Stats::collect());
+    }
+
     return 0;
 }
@@ -0,0 +1,41 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+MappedFile::MappedFile(const std::filesystem::path& file_path): data{nullptr}, size{0} {
+    int file_descriptor = open(file_path.c_str(), O_RDONLY);
+    if (file_descriptor == -1) {
+        throw std::runtime_error{"Couldn't open " + file_path.string() + ".\n"};
+    }
+
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) == -1) {
+        close(file_descriptor);
+        throw std::runtime_error{"Couldn't read the size of " + file_path.string() + ".\n"};
+    }
+
+    this->size = file_status.st_size;
+    if (this->size != 0) {  // mapping zero bytes is an error, an empty file is just an empty view
+        this->data = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    }
+    close(file_descriptor);
+
+    if (this->data == MAP_FAILED) {
+        throw std::runtime_error{"Couldn't map " + file_path.string() + ".\n"};
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (this->data != nullptr) {
+        munmap(this->data, this->size);
+    }
+}
+
+std::string_view MappedFile::getContents() const {
+    return std::string_view{static_cast<const char *>(this->data), this->size};
+}
@@ -0,0 +1,482 @@
+#include "move_evaluator.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "delta_kernels.hpp"
+
+constexpr int reversed_arc_slack = std::numeric_limits<int>::min();
+
+MoveEvaluator::MoveEvaluator(const DependencyGraph& dependency_graph):
+    job_count{dependency_graph.getJobCount()},
+    processing_time{dependency_graph.getProcessingTimes()},
+    sequence_setup_time{dependency_graph.getSequenceSetupTime()},
+    setup_time{dependency_graph.getSequenceSetupTime().getView()},
+    timespan{0},
+    violation_count{0},
+    current_stamp{0} {
+    if (this->job_count <= wide_setup_jobs) {
+        this->wide_setup_time.resize(static_cast<std::size_t>(this->job_count) * this->job_count);
+        this->sequence_setup_time.visit([&](const auto* values) {
+            std::copy(values, values + this->wide_setup_time.size(), this->wide_setup_time.begin());
+        });
+    }
+
+    this->outgoing_arcs_offset.push_back(0);
+    std::vector<int> incoming_arc_count(this->job_count, 0);
+    for (int id = 1; id <= this->job_count; id++) {
+        auto dependents = dependency_graph.getDependents(id);
+        auto delays = dependency_graph.getDependentDelays(id);
+        for (int k = 0; k < dependents.size(); k++) {
+            this->arc_from.push_back(id);
+            this->arc_to.push_back(dependents[k]);
+            this->arc_delay.push_back(delays[k]);
+
+            incoming_arc_count[dependents[k] - 1]++;
+        }
+
+        this->outgoing_arcs_offset.push_back(this->arc_from.size());
+    }
+
+    this->incoming_arcs_offset.assign(this->job_count + 1, 0);
+    std::partial_sum(incoming_arc_count.cbegin(), incoming_arc_count.cend(), std::next(this->incoming_arcs_offset.begin(), 1));
+
+    this->incoming_arcs.resize(this->arc_from.size());
+    std::vector<int> incoming_arcs_fill{this->incoming_arcs_offset.cbegin(), std::prev(this->incoming_arcs_offset.cend())};
+    for (int arc = 0; arc < this->arc_from.size(); arc++) {
+        this->incoming_arcs[incoming_arcs_fill[this->arc_to[arc] - 1]++] = arc;
+    }
+
+    this->schedule.reserve(this->job_count);
+    this->position.resize(this->job_count);
+    this->finish_time.resize(this->job_count);
+    this->forward_setup_sum.resize(this->job_count);
+    this->backward_setup_sum.resize(this->job_count);
+    this->arc_slack.resize(this->arc_from.size());
+    this->arcs_by_slack.resize(this->arc_from.size());
+    this->sorted_slack.resize(this->arc_from.size());
+    this->range_job.resize(this->job_count);
+    this->range_finish_time.resize(this->job_count);
+    this->range_stamp.assign(this->job_count, 0);
+    this->range_position.resize(this->job_count);
+}
+
+void MoveEvaluator::load(const std::vector<int>& schedule) {
+    if (schedule.size() != this->job_count) {
+        throw std::invalid_argument("Schedule doesn't contain every job!\n");
+    }
+
+    this->schedule = schedule;
+    this->rebuild();
+}
+
+void MoveEvaluator::rebuild() {
+    int previous_job = 0;
+    int elapsed_time = 0;
+    for (int i = 0; i < this->job_count; i++) {
+        int job = this->schedule[i];
+
+        elapsed_time += this->setupTime(previous_job, job) + this->processing_time[job - 1];
+        this->position[job - 1] = i;
+        this->finish_time[i] = elapsed_time;
+
+        previous_job = job;
+    }
+
+    this->forward_setup_sum[0] = 0;
+    this->backward_setup_sum[0] = 0;
+    for (int i = 1; i < this->job_count; i++) {
+        this->forward_setup_sum[i] = this->forward_setup_sum[i - 1] + this->setupTime(this->schedule[i - 1], this->schedule[i]);
+        this->backward_setup_sum[i] = this->backward_setup_sum[i - 1] + this->setupTime(this->schedule[i], this->schedule[i - 1]);
+    }
+
+    // calculateTimespan charges the first job's processing time twice
+    this->timespan = elapsed_time + this->processing_time[this->schedule[0] - 1];
+
+    this->violation_count = 0;
+    for (int arc = 0; arc < this->arc_from.size(); arc++) {
+        int from_position = this->position[this->arc_from[arc] - 1];
+        int to_position = this->position[this->arc_to[arc] - 1];
+
+        if (from_position > to_position) {
+            this->arc_slack[arc] = reversed_arc_slack;
+        } else {
+            this->arc_slack[arc] = this->finish_time[to_position - 1] - this->finish_time[from_position] - this->arc_delay[arc];
+        }
+
+        if (this->arc_slack[arc] < 0) {
+            this->violation_count++;
+        }
+    }
+
+    std::iota(this->arcs_by_slack.begin(), this->arcs_by_slack.end(), 0);
+    std::sort(this->arcs_by_slack.begin(), this->arcs_by_slack.end(), [&](int first, int second) {
+        return this->arc_slack[first] < this->arc_slack[second];
+    });
+    for (int i = 0; i < this->arcs_by_slack.size(); i++) {
+        this->sorted_slack[i] = this->arc_slack[this->arcs_by_slack[i]];
+    }
+}
+
+const std::vector<int>& MoveEvaluator::getSchedule() const {
+    return this->schedule;
+}
+
+int MoveEvaluator::getTimespan() const {
+    return this->timespan;
+}
+
+int MoveEvaluator::getPosition(int id) const {
+    return this->position[id - 1];
+}
+
+int MoveEvaluator::getViolationCount() const {
+    return this->violation_count;
+}
+
+int MoveEvaluator::setupTime(int from, int to) const {
+    if (from == 0 || to == 0) {  // 0 stands for "no job", before the first or after the last position
+        return 0;
+    }
+
+    if (!this->wide_setup_time.empty()) {
+        return this->wide_setup_time[(from - 1) * this->job_count + (to - 1)];
+    }
+
+    return this->setup_time(from, to);
+}
+
+int MoveEvaluator::swapTimespanDelta(int first_position, int second_position) const {
+    int i = std::min(first_position, second_position);
+    int j = std::max(first_position, second_position);
+    if (i == j) {
+        return 0;
+    }
+
+    const auto& s = this->schedule;
+    int before = i > 0 ? s[i - 1] : 0;
+    int after = j + 1 < this->job_count ? s[j + 1] : 0;
+
+    int removed;
+    int added;
+    if (j == i + 1) {
+        removed = this->setupTime(before, s[i]) + this->setupTime(s[i], s[j]) + this->setupTime(s[j], after);
+        added = this->setupTime(before, s[j]) + this->setupTime(s[j], s[i]) + this->setupTime(s[i], after);
+    } else {
+        removed = this->setupTime(before, s[i]) + this->setupTime(s[i], s[i + 1]) + this->setupTime(s[j - 1], s[j]) + this->setupTime(s[j], after);
+        added = this->setupTime(before, s[j]) + this->setupTime(s[j], s[i + 1]) + this->setupTime(s[j - 1], s[i]) + this->setupTime(s[i], after);
+    }
+
+    int delta = added - removed;
+    if (i == 0) {
+        delta += this->processing_time[s[j] - 1] - this->processing_time[s[i] - 1];
+    }
+
+    return delta;
+}
+
+int MoveEvaluator::insertTimespanDelta(int from_position, int to_position) const {
+    return this->blockTimespanDelta(from_position, 1, to_position);
+}
+
+int MoveEvaluator::blockTimespanDelta(int from_position, int length, int to_position) const {
+    if (from_position == to_position) {
+        return 0;
+    }
+
+    const auto& s = this->schedule;
+    int first = s[from_position];
+    int last = s[from_position + length - 1];
+
+    // taking the block out joins its two neighbours
+    int before = from_position > 0 ? s[from_position - 1] : 0;
+    int after = from_position + length < this->job_count ? s[from_position + length] : 0;
+    int delta = this->setupTime(before, after) - this->setupTime(before, first) - this->setupTime(last, after);
+
+    // putting it back splits the edge at to_position of the schedule without it
+    auto reduced = [&](int k) {
+        return k < from_position ? s[k] : s[k + length];
+    };
+    before = to_position > 0 ? reduced(to_position - 1) : 0;
+    after = to_position < this->job_count - length ? reduced(to_position) : 0;
+    delta += this->setupTime(before, first) + this->setupTime(last, after) - this->setupTime(before, after);
+
+    int first_job = to_position == 0 ? first : reduced(0);
+    delta += this->processing_time[first_job - 1] - this->processing_time[s[0] - 1];
+
+    return delta;
+}
+
+int MoveEvaluator::reverseTimespanDelta(int first_position, int last_position) const {
+    int i = std::min(first_position, last_position);
+    int j = std::max(first_position, last_position);
+    if (i == j) {
+        return 0;
+    }
+
+    const auto& s = this->schedule;
+    int before = i > 0 ? s[i - 1] : 0;
+    int after = j + 1 < this->job_count ? s[j + 1] : 0;
+
+    int removed = this->setupTime(before, s[i]) + (this->forward_setup_sum[j] - this->forward_setup_sum[i]) + this->setupTime(s[j], after);
+    int added = this->setupTime(before, s[j]) + (this->backward_setup_sum[j] - this->backward_setup_sum[i]) + this->setupTime(s[i], after);
+
+    int delta = added - removed;
+    if (i == 0) {
+        delta += this->processing_time[s[j] - 1] - this->processing_time[s[i] - 1];
+    }
+
+    return delta;
+}
+
+void MoveEvaluator::swapTimespanDeltas(int first_position, std::span<int> deltas) const {
+    const auto& s = this->schedule;
+    int i = first_position;
+    if (i + 1 >= this->job_count) {
+        return;
+    }
+
+    // the neighbouring and last swaps are the ones whose edges overlap or run off the schedule
+    deltas[i + 1] = this->swapTimespanDelta(i, i + 1);
+    if (i + 2 < this->job_count - 1) {
+        int before = i > 0 ? s[i - 1] : 0;
+        int constant = -this->setupTime(s[i], s[i + 1]) - (i > 0 ? this->setupTime(before, s[i]) : this->processing_time[s[i] - 1]);
+
+        int count = this->job_count - 1 - (i + 2);
+        DeltaKernels::swapDeltas(
+            this->sequence_setup_time, this->processing_time.data(), before, &s[i + 1], &s[i + 2], &s[i + 3], count,
+            s[i], s[i + 1], constant, &deltas[i + 2]
+        );
+    }
+    if (i + 2 <= this->job_count - 1) {
+        deltas[this->job_count - 1] = this->swapTimespanDelta(i, this->job_count - 1);
+    }
+}
+
+void MoveEvaluator::insertTimespanDeltas(int from_position, std::span<int> deltas) const {
+    this->blockTimespanDeltas(from_position, 1, deltas);
+}
+
+void MoveEvaluator::blockTimespanDeltas(int from_position, int length, std::span<int> deltas) const {
+    const auto& s = this->schedule;
+    int i = from_position;
+    int last_position = this->job_count - length;
+    int first = s[i];
+    int last = s[i + length - 1];
+
+    int before = i > 0 ? s[i - 1] : 0;
+    int after = i + length < this->job_count ? s[i + length] : 0;
+    int removal = this->setupTime(before, after) - this->setupTime(before, first) - this->setupTime(last, after);
+
+    // past position 0 the first job of the moved schedule is the first one of the schedule without the block
+    int first_job = i == 0 ? s[length] : s[0];
+    int constant = removal + this->processing_time[first_job - 1] - this->processing_time[s[0] - 1];
+
+    // to_position k splits the edge from k - 1 to k of the schedule without the block, which is the
+    // schedule itself before from_position and the schedule shifted by length after it
+    deltas[0] = this->blockTimespanDelta(i, length, 0);
+    if (i > 1) {
+        DeltaKernels::insertionDeltas(
+            this->sequence_setup_time, &s[0], &s[1], i - 1, first, last, constant, &deltas[1]
+        );
+    }
+    deltas[i] = 0;
+    if (last_position - (i + 1) > 0) {
+        DeltaKernels::insertionDeltas(
+            this->sequence_setup_time, &s[i + length], &s[i + length + 1], last_position - (i + 1),
+            first, last, constant, &deltas[i + 1]
+        );
+    }
+    if (last_position > 0) {
+        deltas[last_position] = this->blockTimespanDelta(i, length, last_position);
+    }
+}
+
+void MoveEvaluator::reverseTimespanDeltas(int first_position, std::span<int> deltas) const {
+    const auto& s = this->schedule;
+    int i = first_position;
+    if (i + 1 >= this->job_count) {
+        return;
+    }
+
+    deltas[i + 1] = this->reverseTimespanDelta(i, i + 1);
+    if (i + 2 < this->job_count - 1) {
+        int before = i > 0 ? s[i - 1] : 0;
+        int constant = this->forward_setup_sum[i] - this->backward_setup_sum[i]
+                     - (i > 0 ? this->setupTime(before, s[i]) : this->processing_time[s[i] - 1]);
+
+        int count = this->job_count - 1 - (i + 2);
+        DeltaKernels::reversalDeltas(
+            this->sequence_setup_time, this->processing_time.data(), before, &s[i + 2], &s[i + 3],
+            &this->forward_setup_sum[i + 2], &this->backward_setup_sum[i + 2], count, s[i], constant, &deltas[i + 2]
+        );
+    }
+    if (i + 2 <= this->job_count - 1) {
+        deltas[this->job_count - 1] = this->reverseTimespanDelta(i, this->job_count - 1);
+    }
+}
+
+int MoveEvaluator::swapViolationCount(int first_position, int second_position) {
+    int i = std::min(first_position, second_position);
+    int j = std::max(first_position, second_position);
+    if (i == j) {
+        return this->violation_count;
+    }
+
+    int range_end = std::min(j + 1, this->job_count - 1);
+    for (int k = i; k <= range_end; k++) {
+        this->range_job[k - i] = this->schedule[k];
+    }
+    this->range_job[0] = this->schedule[j];
+    this->range_job[j - i] = this->schedule[i];
+
+    return this->violationCount(i, range_end);
+}
+
+int MoveEvaluator::insertViolationCount(int from_position, int to_position) {
+    return this->blockViolationCount(from_position, 1, to_position);
+}
+
+int MoveEvaluator::blockViolationCount(int from_position, int length, int to_position) {
+    if (from_position == to_position) {
+        return this->violation_count;
+    }
+
+    int range_begin = std::min(from_position, to_position);
+    int range_end = std::min(std::max(from_position, to_position) + length, this->job_count - 1);
+    for (int k = range_begin; k <= range_end; k++) {
+        int source;
+        if (k >= to_position && k < to_position + length) {
+            source = from_position + (k - to_position);
+        } else {
+            // position k of the schedule without the block, skipping the block's slots at to_position
+            int reduced_position = k < to_position ? k : k - length;
+            source = reduced_position < from_position ? reduced_position : reduced_position + length;
+        }
+
+        this->range_job[k - range_begin] = this->schedule[source];
+    }
+
+    return this->violationCount(range_begin, range_end);
+}
+
+int MoveEvaluator::reverseViolationCount(int first_position, int last_position) {
+    int i = std::min(first_position, last_position);
+    int j = std::max(first_position, last_position);
+    if (i == j) {
+        return this->violation_count;
+    }
+
+    int range_end = std::min(j + 1, this->job_count - 1);
+    for (int k = i; k <= range_end; k++) {
+        this->range_job[k - i] = k <= j ? this->schedule[i + j - k] : this->schedule[k];
+    }
+
+    return this->violationCount(i, range_end);
+}
+
+// expects range_job to hold the moved jobs of positions [range_begin, range_end], and the job right
+// after the last moved position to be part of the range since its setup edge changes too
+int MoveEvaluator::violationCount(int range_begin, int range_end) {
+    this->current_stamp++;
+
+    int previous_job = range_begin > 0 ? this->schedule[range_begin - 1] : 0;
+    int elapsed_time = range_begin > 0 ? this->finish_time[range_begin - 1] : 0;
+    for (int k = range_begin; k <= range_end; k++) {
+        int job = this->range_job[k - range_begin];
+
+        elapsed_time += this->setupTime(previous_job, job) + this->processing_time[job - 1];
+        this->range_finish_time[k - range_begin] = elapsed_time;
+        this->range_stamp[job - 1] = this->current_stamp;
+        this->range_position[job - 1] = k;
+
+        previous_job = job;
+    }
+
+    // every position after the range moves by the same amount
+    int shift = elapsed_time - this->finish_time[range_end];
+
+    auto new_position = [&](int job) {
+        return this->range_stamp[job - 1] == this->current_stamp ? this->range_position[job - 1] : this->position[job - 1];
+    };
+    auto new_finish_time = [&](int k) {
+        if (k < range_begin) {
+            return this->finish_time[k];
+        }
+        if (k > range_end) {
+            return this->finish_time[k] + shift;
+        }
+        return this->range_finish_time[k - range_begin];
+    };
+    auto violated = [&](int arc) {
+        int from_position = new_position(this->arc_from[arc]);
+        int to_position = new_position(this->arc_to[arc]);
+
+        return from_position > to_position || new_finish_time(to_position - 1) - new_finish_time(from_position) < this->arc_delay[arc];
+    };
+
+    int violations = this->violation_count;
+
+    // arcs touching the range, an arc with both ends inside is counted through its "to" job
+    for (int k = range_begin; k <= range_end; k++) {
+        int job = this->schedule[k];
+
+        for (int i = this->incoming_arcs_offset[job - 1]; i < this->incoming_arcs_offset[job]; i++) {
+            int arc = this->incoming_arcs[i];
+            violations += violated(arc) - (this->arc_slack[arc] < 0);
+        }
+
+        for (int arc = this->outgoing_arcs_offset[job - 1]; arc < this->outgoing_arcs_offset[job]; arc++) {
+            if (this->range_stamp[this->arc_to[arc] - 1] != this->current_stamp) {
+                violations += violated(arc) - (this->arc_slack[arc] < 0);
+            }
+        }
+    }
+
+    // arcs spanning the whole range only see their slack move by the shift, so just the ones
+    // whose slack sits between 0 and -shift can change state
+    if (shift != 0) {
+        int lowest_slack = std::min(0, -shift);
+        int highest_slack = std::max(0, -shift);
+
+        auto iterator = std::lower_bound(this->sorted_slack.cbegin(), this->sorted_slack.cend(), lowest_slack);
+        for (; iterator != this->sorted_slack.cend() && *iterator < highest_slack; iterator++) {
+            int arc = this->arcs_by_slack[std::distance(this->sorted_slack.cbegin(), iterator)];
+
+            if (this->position[this->arc_from[arc] - 1] < range_begin && this->position[this->arc_to[arc] - 1] > range_end) {
+                violations += shift < 0 ? 1 : -1;
+            }
+        }
+    }
+
+    return violations;
+}
+
+void MoveEvaluator::applySwap(int first_position, int second_position) {
+    std::swap(this->schedule[first_position], this->schedule[second_position]);
+    this->rebuild();
+}
+
+void MoveEvaluator::applyInsert(int from_position, int to_position) {
+    this->applyBlock(from_position, 1, to_position);
+}
+
+void MoveEvaluator::applyBlock(int from_position, int length, int to_position) {
+    auto begin = this->schedule.begin();
+    if (to_position < from_position) {
+        std::rotate(begin + to_position, begin + from_position, begin + from_position + length);
+    } else {
+        std::rotate(begin + from_position, begin + from_position + length, begin + to_position + length);
+    }
+    this->rebuild();
+}
+
+void MoveEvaluator::applyReverse(int first_position, int last_position) {
+    int i = std::min(first_position, last_position);
+    int j = std::max(first_position, last_position);
+
+    std::reverse(this->schedule.begin() + i, this->schedule.begin() + j + 1);
+    this->rebuild();
+}
@@ -0,0 +1,454 @@
+#include "neighborhood.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+bool Move::found() const {
+    return this->row >= 0;
+}
+
+bool Move::operator<(const Move& other) const {
+    return std::tie(this->violations, this->timespan_delta, this->row, this->column)
+         < std::tie(other.violations, other.timespan_delta, other.row, other.column);
+}
+
+bool SwapNeighborhood::improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) {
+    Stats::ScopedTimer timer{Stats::swap_phase};
+
+    int job_count = move_evaluator.getSchedule().size();
+    long long start_moves = moves_evaluated;
+    bool improved = false;
+    this->timespan_deltas.resize(job_count);
+
+    for (int i = 0; i < job_count && !improved; i++) {
+        move_evaluator.swapTimespanDeltas(i, this->timespan_deltas);
+        for (int j = i + 1; j < job_count; j++) {
+            auto violation_count = [&]() {
+                return move_evaluator.swapViolationCount(i, j);
+            };
+
+            moves_evaluated++;
+            if (accepts(move_evaluator, this->timespan_deltas[j], violation_count, Stats::swap_moves_feasible, Stats::swap_moves_improving)) {
+                move_evaluator.applySwap(i, j);
+
+                improved = true;
+                break;
+            }
+        }
+    }
+
+    Stats::add(Stats::swap_moves_generated, moves_evaluated - start_moves);
+
+    return improved;
+}
+
+int SwapNeighborhood::rowCount(int job_count) const {
+    return job_count;
+}
+
+void SwapNeighborhood::scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const {
+    int job_count = move_evaluator.getSchedule().size();
+    int i = row;
+
+    move_evaluator.swapTimespanDeltas(i, deltas);
+    for (int j = i + 1; j < job_count; j++) {
+        auto violation_count = [&]() {
+            return move_evaluator.swapViolationCount(i, j);
+        };
+
+        consider(move_evaluator, deltas[j], violation_count, row, j, best, Stats::swap_moves_feasible);
+    }
+
+    moves_evaluated += job_count - 1 - i;
+    Stats::add(Stats::swap_moves_generated, job_count - 1 - i);
+}
+
+void SwapNeighborhood::apply(MoveEvaluator& move_evaluator, const Move& move) const {
+    move_evaluator.applySwap(move.row, move.column);
+    Stats::add(Stats::swap_moves_improving);
+}
+
+Stats::Phase SwapNeighborhood::phase() const {
+    return Stats::swap_phase;
+}
+
+bool InsertNeighborhood::improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) {
+    Stats::ScopedTimer timer{Stats::insert_phase};
+
+    int job_count = move_evaluator.getSchedule().size();
+    long long start_moves = moves_evaluated;
+    bool improved = false;
+    this->timespan_deltas.resize(job_count);
+
+    for (int i = 0; i < job_count && !improved; i++) {
+        move_evaluator.insertTimespanDeltas(i, this->timespan_deltas);
+        for (int j = 0; j < job_count; j++) {
+            if (i == j) {
+                continue;
+            }
+
+            auto violation_count = [&]() {
+                return move_evaluator.insertViolationCount(i, j);
+            };
+
+            moves_evaluated++;
+            if (accepts(move_evaluator, this->timespan_deltas[j], violation_count, Stats::insert_moves_feasible, Stats::insert_moves_improving)) {
+                move_evaluator.applyInsert(i, j);
+
+                improved = true;
+                break;
+            }
+        }
+    }
+
+    Stats::add(Stats::insert_moves_generated, moves_evaluated - start_moves);
+
+    return improved;
+}
+
+int InsertNeighborhood::rowCount(int job_count) const {
+    return job_count;
+}
+
+void InsertNeighborhood::scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const {
+    int job_count = move_evaluator.getSchedule().size();
+    int i = row;
+
+    move_evaluator.insertTimespanDeltas(i, deltas);
+    for (int j = 0; j < job_count; j++) {
+        if (i == j) {
+            continue;
+        }
+
+        auto violation_count = [&]() {
+            return move_evaluator.insertViolationCount(i, j);
+        };
+
+        consider(move_evaluator, deltas[j], violation_count, row, j, best, Stats::insert_moves_feasible);
+    }
+
+    moves_evaluated += job_count - 1;
+    Stats::add(Stats::insert_moves_generated, job_count - 1);
+}
+
+void InsertNeighborhood::apply(MoveEvaluator& move_evaluator, const Move& move) const {
+    move_evaluator.applyInsert(move.row, move.column);
+    Stats::add(Stats::insert_moves_improving);
+}
+
+Stats::Phase InsertNeighborhood::phase() const {
+    return Stats::insert_phase;
+}
+
+GranularSwapNeighborhood::GranularSwapNeighborhood(const CandidateLists& candidate_lists) : candidate_lists{candidate_lists} {}
+
+template<typename Visit>
+bool GranularSwapNeighborhood::forEachMove(const MoveEvaluator& move_evaluator, int row, Visit visit) const {
+    int job_count = move_evaluator.getSchedule().size();
+    int job = move_evaluator.getSchedule()[row];
+
+    // the other job leaves the spot after the predecessor or before the successor, which stays put
+    for (int predecessor : this->candidate_lists.getPredecessors(job)) {
+        int column = move_evaluator.getPosition(predecessor) + 1;
+        if (column != row && column < job_count && visit(column)) {
+            return true;
+        }
+    }
+    for (int successor : this->candidate_lists.getSuccessors(job)) {
+        int column = move_evaluator.getPosition(successor) - 1;
+        if (column != row && column >= 0 && visit(column)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool GranularSwapNeighborhood::improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) {
+    Stats::ScopedTimer timer{Stats::swap_phase};
+
+    int job_count = move_evaluator.getSchedule().size();
+    long long start_moves = moves_evaluated;
+    bool improved = false;
+
+    for (int i = 0; i < job_count && !improved; i++) {
+        improved = this->forEachMove(move_evaluator, i, [&](int j) {
+            auto violation_count = [&]() {
+                return move_evaluator.swapViolationCount(i, j);
+            };
+
+            moves_evaluated++;
+            if (accepts(move_evaluator, move_evaluator.swapTimespanDelta(i, j), violation_count, Stats::swap_moves_feasible, Stats::swap_moves_improving)) {
+                move_evaluator.applySwap(i, j);
+                return true;
+            }
+
+            return false;
+        });
+    }
+
+    Stats::add(Stats::swap_moves_generated, moves_evaluated - start_moves);
+
+    return improved;
+}
+
+int GranularSwapNeighborhood::rowCount(int job_count) const {
+    return job_count;
+}
+
+// a row holds only the candidates' moves, too few for the batch deltas to pay for a whole row
+void GranularSwapNeighborhood::scanRow(MoveEvaluator& move_evaluator, int row, std::span<int>, Move& best, long long& moves_evaluated) const {
+    long long row_moves = 0;
+    this->forEachMove(move_evaluator, row, [&](int column) {
+        auto violation_count = [&]() {
+            return move_evaluator.swapViolationCount(row, column);
+        };
+
+        consider(move_evaluator, move_evaluator.swapTimespanDelta(row, column), violation_count, row, column, best, Stats::swap_moves_feasible);
+        row_moves++;
+
+        return false;
+    });
+
+    moves_evaluated += row_moves;
+    Stats::add(Stats::swap_moves_generated, row_moves);
+}
+
+void GranularSwapNeighborhood::apply(MoveEvaluator& move_evaluator, const Move& move) const {
+    move_evaluator.applySwap(move.row, move.column);
+    Stats::add(Stats::swap_moves_improving);
+}
+
+Stats::Phase GranularSwapNeighborhood::phase() const {
+    return Stats::swap_phase;
+}
+
+GranularInsertNeighborhood::GranularInsertNeighborhood(const CandidateLists& candidate_lists) : candidate_lists{candidate_lists} {}
+
+template<typename Visit>
+bool GranularInsertNeighborhood::forEachMove(const MoveEvaluator& move_evaluator, int row, Visit visit) const {
+    int job = move_evaluator.getSchedule()[row];
+
+    // positions count in the schedule after the move, where the jobs behind row moved up by one
+    for (int predecessor : this->candidate_lists.getPredecessors(job)) {
+        int position = move_evaluator.getPosition(predecessor);
+        int column = position < row ? position + 1 : position;
+        if (column != row && visit(column)) {
+            return true;
+        }
+    }
+    for (int successor : this->candidate_lists.getSuccessors(job)) {
+        int position = move_evaluator.getPosition(successor);
+        int column = position < row ? position : position - 1;
+        if (column != row && visit(column)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool GranularInsertNeighborhood::improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) {
+    Stats::ScopedTimer timer{Stats::insert_phase};
+
+    int job_count = move_evaluator.getSchedule().size();
+    long long start_moves = moves_evaluated;
+    bool improved = false;
+
+    for (int i = 0; i < job_count && !improved; i++) {
+        improved = this->forEachMove(move_evaluator, i, [&](int j) {
+            auto violation_count = [&]() {
+                return move_evaluator.insertViolationCount(i, j);
+            };
+
+            moves_evaluated++;
+            if (accepts(move_evaluator, move_evaluator.insertTimespanDelta(i, j), violation_count, Stats::insert_moves_feasible, Stats::insert_moves_improving)) {
+                move_evaluator.applyInsert(i, j);
+                return true;
+            }
+
+            return false;
+        });
+    }
+
+    Stats::add(Stats::insert_moves_generated, moves_evaluated - start_moves);
+
+    return improved;
+}
+
+int GranularInsertNeighborhood::rowCount(int job_count) const {
+    return job_count;
+}
+
+// a row holds only the candidates' moves, too few for the batch deltas to pay for a whole row
+void GranularInsertNeighborhood::scanRow(MoveEvaluator& move_evaluator, int row, std::span<int>, Move& best, long long& moves_evaluated) const {
+    long long row_moves = 0;
+    this->forEachMove(move_evaluator, row, [&](int column) {
+        auto violation_count = [&]() {
+            return move_evaluator.insertViolationCount(row, column);
+        };
+
+        consider(move_evaluator, move_evaluator.insertTimespanDelta(row, column), violation_count, row, column, best, Stats::insert_moves_feasible);
+        row_moves++;
+
+        return false;
+    });
+
+    moves_evaluated += row_moves;
+    Stats::add(Stats::insert_moves_generated, row_moves);
+}
+
+void GranularInsertNeighborhood::apply(MoveEvaluator& move_evaluator, const Move& move) const {
+    move_evaluator.applyInsert(move.row, move.column);
+    Stats::add(Stats::insert_moves_improving);
+}
+
+Stats::Phase GranularInsertNeighborhood::phase() const {
+    return Stats::insert_phase;
+}
+
+BlockNeighborhood::BlockNeighborhood(int max_length) : max_length{max_length} {}
+
+bool BlockNeighborhood::improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) {
+    Stats::ScopedTimer timer{Stats::block_phase};
+
+    int job_count = move_evaluator.getSchedule().size();
+    long long start_moves = moves_evaluated;
+    bool improved = false;
+    this->timespan_deltas.resize(job_count);
+
+    for (int length = 2; length <= std::min(this->max_length, job_count - 1) && !improved; length++) {
+        for (int i = 0; i + length <= job_count && !improved; i++) {
+            move_evaluator.blockTimespanDeltas(i, length, this->timespan_deltas);
+            for (int j = 0; j + length <= job_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+
+                auto violation_count = [&]() {
+                    return move_evaluator.blockViolationCount(i, length, j);
+                };
+
+                moves_evaluated++;
+                if (accepts(move_evaluator, this->timespan_deltas[j], violation_count, Stats::block_moves_feasible, Stats::block_moves_improving)) {
+                    move_evaluator.applyBlock(i, length, j);
+
+                    improved = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    Stats::add(Stats::block_moves_generated, moves_evaluated - start_moves);
+
+    return improved;
+}
+
+// row (length - 2) * job_count + i holds the block of that length starting at i, empty past the end
+int BlockNeighborhood::rowCount(int job_count) const {
+    return std::max(0, std::min(this->max_length, job_count - 1) - 1) * job_count;
+}
+
+void BlockNeighborhood::scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const {
+    int job_count = move_evaluator.getSchedule().size();
+    int length = row / job_count + 2;
+    int i = row % job_count;
+    if (i + length > job_count) {
+        return;
+    }
+
+    move_evaluator.blockTimespanDeltas(i, length, deltas);
+    for (int j = 0; j + length <= job_count; j++) {
+        if (i == j) {
+            continue;
+        }
+
+        auto violation_count = [&]() {
+            return move_evaluator.blockViolationCount(i, length, j);
+        };
+
+        consider(move_evaluator, deltas[j], violation_count, row, j, best, Stats::block_moves_feasible);
+    }
+
+    moves_evaluated += job_count - length;
+    Stats::add(Stats::block_moves_generated, job_count - length);
+}
+
+void BlockNeighborhood::apply(MoveEvaluator& move_evaluator, const Move& move) const {
+    int job_count = move_evaluator.getSchedule().size();
+    move_evaluator.applyBlock(move.row % job_count, move.row / job_count + 2, move.column);
+    Stats::add(Stats::block_moves_improving);
+}
+
+Stats::Phase BlockNeighborhood::phase() const {
+    return Stats::block_phase;
+}
+
+ReversalNeighborhood::ReversalNeighborhood(int max_length) : max_length{max_length} {}
+
+bool ReversalNeighborhood::improve(MoveEvaluator& move_evaluator, long long& moves_evaluated) {
+    Stats::ScopedTimer timer{Stats::reversal_phase};
+
+    int job_count = move_evaluator.getSchedule().size();
+    int max_length = this->max_length > 0 ? this->max_length : job_count;
+    long long start_moves = moves_evaluated;
+    bool improved = false;
+    this->timespan_deltas.resize(job_count);
+
+    for (int i = 0; i < job_count && !improved; i++) {
+        move_evaluator.reverseTimespanDeltas(i, this->timespan_deltas);
+        for (int j = i + 2; j < std::min(job_count, i + max_length); j++) {
+            auto violation_count = [&]() {
+                return move_evaluator.reverseViolationCount(i, j);
+            };
+
+            moves_evaluated++;
+            if (accepts(move_evaluator, this->timespan_deltas[j], violation_count, Stats::reversal_moves_feasible, Stats::reversal_moves_improving)) {
+                move_evaluator.applyReverse(i, j);
+
+                improved = true;
+                break;
+            }
+        }
+    }
+
+    Stats::add(Stats::reversal_moves_generated, moves_evaluated - start_moves);
+
+    return improved;
+}
+
+int ReversalNeighborhood::rowCount(int job_count) const {
+    return job_count;
+}
+
+void ReversalNeighborhood::scanRow(MoveEvaluator& move_evaluator, int row, std::span<int> deltas, Move& best, long long& moves_evaluated) const {
+    int job_count = move_evaluator.getSchedule().size();
+    int max_length = this->max_length > 0 ? this->max_length : job_count;
+    int i = row;
+    int end = std::min(job_count, i + max_length);
+    if (i + 2 >= end) {
+        return;
+    }
+
+    move_evaluator.reverseTimespanDeltas(i, deltas);
+    for (int j = i + 2; j < end; j++) {
+        auto violation_count = [&]() {
+            return move_evaluator.reverseViolationCount(i, j);
+        };
+
+        consider(move_evaluator, deltas[j], violation_count, row, j, best, Stats::reversal_moves_feasible);
+    }
+
+    moves_evaluated += end - (i + 2);
+    Stats::add(Stats::reversal_moves_generated, end - (i + 2));
+}
+
+void ReversalNeighborhood::apply(MoveEvaluator& move_evaluator, const Move& move) const {
+    move_evaluator.applyReverse(move.row, move.column);
+    Stats::add(Stats::reversal_moves_improving);
+}
+
+Stats::Phase ReversalNeighborhood::phase() const {
+    return Stats::reversal_phase;
+}
@@ -0,0 +1,59 @@
+#include "reactive_alpha.hpp"
+
+#include <cmath>
+#include <limits>
+
+ReactiveAlpha::ReactiveAlpha():
+    runs{},
+    valid_runs{},
+    timespan_sum{},
+    best_timespan{std::numeric_limits<int>::max()},
+    pending_records{0} {
+    std::array<double, values.size()> weights;
+    weights.fill(1);
+    this->distribution = std::discrete_distribution<>(weights.begin(), weights.end());
+}
+
+int ReactiveAlpha::draw(std::mt19937& generator) {
+    return this->distribution(generator);
+}
+
+void ReactiveAlpha::record(int index, int timespan, bool valid) {
+    this->runs[index]++;
+    if (valid) {
+        this->valid_runs[index]++;
+        this->timespan_sum[index] += timespan;
+        this->best_timespan = std::min(this->best_timespan, timespan);
+    }
+
+    if (++this->pending_records == update_period) {
+        this->pending_records = 0;
+        this->update();
+    }
+}
+
+void ReactiveAlpha::update() {
+    std::array<double, values.size()> quality{};
+    double quality_sum = 0;
+    for (int i = 0; i < values.size(); i++) {
+        if (this->valid_runs[i] == 0) {
+            continue;
+        }
+
+        double mean_timespan = static_cast<double>(this->timespan_sum[i]) / this->valid_runs[i];
+        double valid_share = static_cast<double>(this->valid_runs[i]) / this->runs[i];
+        quality[i] = valid_share * std::pow(this->best_timespan / mean_timespan, amplification);
+        quality_sum += quality[i];
+    }
+
+    // nothing valid yet, so nothing to tell the values apart by
+    if (quality_sum == 0) {
+        return;
+    }
+
+    std::array<double, values.size()> weights;
+    for (int i = 0; i < values.size(); i++) {
+        weights[i] = 0.9 * quality[i] / quality_sum + 0.1 / values.size();
+    }
+    this->distribution = std::discrete_distribution<>(weights.begin(), weights.end());
+}
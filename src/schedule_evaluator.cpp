@@ -0,0 +1,58 @@
+#include "schedule_evaluator.hpp"
+
+#include "stats.hpp"
+
+ScheduleEvaluator::ScheduleEvaluator(const DependencyGraph& dependency_graph):
+    job_count{dependency_graph.getJobCount()},
+    processing_time{dependency_graph.getProcessingTimes()},
+    sequence_setup_time{dependency_graph.getSequenceSetupTime()},
+    dependency_graph{dependency_graph},
+    placed_stamp(dependency_graph.getJobCount(), 0),
+    finish_time(dependency_graph.getJobCount(), 0),
+    current_stamp{0} {}
+
+ScheduleEvaluator::Evaluation ScheduleEvaluator::evaluate(std::span<const int> schedule) {
+    Stats::add(Stats::validity_checks);
+
+    if (schedule.size() != this->job_count) {
+        Stats::add(Stats::validity_rejections);
+        return {0, false};
+    }
+
+    this->current_stamp++;
+
+    // every dependency has to be placed already, and the time since it finished (setups included)
+    // has to cover the arc's delay by the time the job starts; the timespan is kept on going after
+    // a broken arc, so an invalid schedule is still scored
+    bool valid = true;
+    int previous_id = 0;
+    int elapsed_time = 0;
+    for (int id : schedule) {
+        if (id < 1 || id > this->job_count || this->placed_stamp[id - 1] == this->current_stamp) {
+            Stats::add(Stats::validity_rejections);
+            return {0, false};
+        }
+
+        auto dependencies = this->dependency_graph.getDependencies(id);
+        auto delays = this->dependency_graph.getDependencyDelays(id);
+        for (int k = 0; k < dependencies.size(); k++) {
+            if (this->placed_stamp[dependencies[k] - 1] != this->current_stamp ||
+                elapsed_time - this->finish_time[dependencies[k] - 1] < delays[k]) {
+                valid = false;
+            }
+        }
+
+        elapsed_time += (previous_id == 0 ? 0 : this->sequence_setup_time(previous_id, id)) + this->processing_time[id - 1];
+        this->placed_stamp[id - 1] = this->current_stamp;
+        this->finish_time[id - 1] = elapsed_time;
+
+        previous_id = id;
+    }
+
+    if (!valid) {
+        Stats::add(Stats::validity_rejections);
+    }
+
+    // calculateTimespan charges the first job's processing time twice
+    return {elapsed_time + this->processing_time[schedule[0] - 1], valid};
+}
@@ -0,0 +1,117 @@
+#include "setup_matrix.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// a 32-bit load at the last entry reads at most this many entries past it
+constexpr int padding_entries = 4;
+
+template<typename T>
+void fill(std::vector<T>& target, std::span<const int> values) {
+    target.assign(values.size() + padding_entries, 0);
+    std::copy(values.begin(), values.end(), target.begin());
+}
+
+template<typename T>
+void fill(std::vector<T>& target, std::span<const char> bytes) {
+    target.assign(bytes.size() / sizeof(T) + padding_entries, 0);
+    std::memcpy(target.data(), bytes.data(), bytes.size());
+}
+
+SetupMatrix::SetupMatrix(): job_count{0}, width{Width::bits32} {
+    this->bindView();
+}
+
+SetupMatrix::SetupMatrix(int job_count, std::span<const int> values): job_count{job_count} {
+    auto [smallest, largest] = std::minmax_element(values.begin(), values.end());
+
+    if (values.empty() || (*smallest >= 0 && *largest <= std::numeric_limits<std::uint8_t>::max())) {
+        this->width = Width::bits8;
+        fill(this->values8, values);
+    } else if (*smallest >= 0 && *largest <= std::numeric_limits<std::uint16_t>::max()) {
+        this->width = Width::bits16;
+        fill(this->values16, values);
+    } else {
+        this->width = Width::bits32;
+        fill(this->values32, values);
+    }
+
+    this->bindView();
+}
+
+SetupMatrix::SetupMatrix(int job_count, Width width, std::span<const char> bytes): job_count{job_count}, width{width} {
+    switch (width) {
+        case Width::bits8:
+            fill(this->values8, bytes);
+            break;
+        case Width::bits16:
+            fill(this->values16, bytes);
+            break;
+        default:
+            fill(this->values32, bytes);
+            break;
+    }
+
+    this->bindView();
+}
+
+SetupMatrix::SetupMatrix(const SetupMatrix& other):
+    job_count{other.job_count},
+    width{other.width},
+    values8{other.values8},
+    values16{other.values16},
+    values32{other.values32} {
+    this->bindView();
+}
+
+SetupMatrix& SetupMatrix::operator=(const SetupMatrix& other) {
+    this->job_count = other.job_count;
+    this->width = other.width;
+    this->values8 = other.values8;
+    this->values16 = other.values16;
+    this->values32 = other.values32;
+    this->bindView();
+
+    return *this;
+}
+
+void SetupMatrix::bindView() {
+    this->view.entries = this->visit([](const auto* values) {
+        return reinterpret_cast<const char*>(values);
+    });
+    this->view.job_count = this->job_count;
+    this->view.entry_shift = this->width == Width::bits8 ? 0 : this->width == Width::bits16 ? 1 : 2;
+    this->view.entry_mask = this->width == Width::bits8 ? 0xff : this->width == Width::bits16 ? 0xffff : 0xffffffff;
+}
+
+SetupMatrix::View SetupMatrix::getView() const {
+    return this->view;
+}
+
+int SetupMatrix::getJobCount() const {
+    return this->job_count;
+}
+
+SetupMatrix::Width SetupMatrix::getWidth() const {
+    return this->width;
+}
+
+std::span<const char> SetupMatrix::getBytes() const {
+    std::size_t entry_count = static_cast<std::size_t>(this->job_count) * this->job_count;
+
+    return this->visit([&](const auto* values) {
+        return std::span{reinterpret_cast<const char*>(values), entry_count * sizeof(*values)};
+    });
+}
+
+std::size_t SetupMatrix::entrySize(Width width) {
+    switch (width) {
+        case Width::bits8:
+            return 1;
+        case Width::bits16:
+            return 2;
+        default:
+            return 4;
+    }
+}
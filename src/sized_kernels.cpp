@@ -0,0 +1,267 @@
+#include "sized_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include "greedy.hpp"
+#include "stats.hpp"
+
+// Ids index the arrays directly and bit id of a bitset is job id, so a class of stride S holds
+// jobs 1 to S - 1; the bitsets have a compile-time word count, which unrolls every loop over them.
+template<int stride>
+class FixedKernels final : public SizedKernels {
+    public:
+        FixedKernels(const DependencyGraph& dependency_graph);
+
+        int getMaxJobCount() const override;
+
+        std::vector<int> construct(float alpha, unsigned int seed) override;
+        ScheduleEvaluator::Evaluation evaluate(std::span<const int> schedule) override;
+
+    private:
+        static constexpr int words = (stride + 63) / 64;
+        using Bits = std::array<std::uint64_t, words>;
+
+        const DependencyGraph& dependency_graph;
+        int job_count;
+
+        // entry (from, to) at from * stride + to; from = 0 is the empty position before the first job,
+        // where setups are 0 and choice points are the construction's first pick formula
+        std::array<int, stride * stride> setup_time;
+        std::array<int, stride * stride> precedence_delay;
+        std::array<float, stride * stride> choice_points;
+        std::array<int, stride> processing_time;
+        std::array<int, stride> dependency_count;
+        std::array<Bits, stride> dependencies;
+};
+
+template<int stride>
+FixedKernels<stride>::FixedKernels(const DependencyGraph& dependency_graph):
+    dependency_graph{dependency_graph},
+    job_count{dependency_graph.getJobCount()},
+    setup_time{},
+    precedence_delay{},
+    choice_points{},
+    processing_time{},
+    dependency_count{},
+    dependencies{} {
+    auto processing_time = dependency_graph.getProcessingTimes();
+    const auto& sequence_setup_time = dependency_graph.getSequenceSetupTime();
+    auto cascaded_dependents_delay = dependency_graph.getCascadedDependentsDelay();
+    auto mean_setup_time = dependency_graph.getMeanSetupTime();
+
+    for (int id = 1; id <= this->job_count; id++) {
+        this->processing_time[id] = processing_time[id - 1];
+
+        // the same expressions as greedyRandomizedAdaptiveProcedure, so the floats come out identical
+        this->choice_points[id] = ((processing_time[id - 1] + mean_setup_time[id - 1]) / 2) - (cascaded_dependents_delay[id - 1] * Greedy::dependent_delay_multiplier);
+        for (int from = 1; from <= this->job_count; from++) {
+            int sequence_setup = sequence_setup_time(from, id);
+
+            this->setup_time[from * stride + id] = sequence_setup;
+            this->choice_points[from * stride + id] = sequence_setup - ((float) cascaded_dependents_delay[id - 1] * Greedy::dependent_delay_multiplier);
+        }
+
+        this->dependency_count[id] = dependency_graph.getDependencies(id).size();
+        for (int dependency : dependency_graph.getDependencies(id)) {
+            this->dependencies[id][dependency / 64] |= std::uint64_t{1} << (dependency % 64);
+        }
+
+        // the delays of the arcs there are, the rest of the matrix is never read; a pair of jobs
+        // joined by several arcs keeps the longest delay, the only one that can still bind
+        auto dependents = dependency_graph.getDependents(id);
+        auto dependent_delays = dependency_graph.getDependentDelays(id);
+        for (int dependent : dependents) {
+            this->precedence_delay[id * stride + dependent] = std::numeric_limits<int>::min();
+        }
+        for (int k = 0; k < dependents.size(); k++) {
+            auto& delay = this->precedence_delay[id * stride + dependents[k]];
+            delay = std::max(delay, dependent_delays[k]);
+        }
+    }
+}
+
+template<int stride>
+int FixedKernels<stride>::getMaxJobCount() const {
+    return stride - 1;
+}
+
+// greedyRandomizedAdaptiveProcedure step for step, down to the order of the candidate and waiting lists
+template<int stride>
+std::vector<int> FixedKernels<stride>::construct(float alpha, unsigned int seed) {
+    Stats::ScopedTimer timer{Stats::construction};
+    Stats::add(Stats::constructions);
+
+    std::array<int, stride> remaining_dependencies = this->dependency_count;
+    std::array<int, stride> release_time{};
+    Bits ready{};
+    std::array<int, stride> waiting;
+    int waiting_count = 0;
+    std::array<std::pair<int, float>, stride> candidate_list;
+
+    for (int id = 1; id <= this->job_count; id++) {
+        if (remaining_dependencies[id] == 0) {
+            ready[id / 64] |= std::uint64_t{1} << (id % 64);
+        }
+    }
+
+    std::vector<int> solution;
+    solution.reserve(this->job_count);
+    std::mt19937 generator{seed};
+
+    int elapsed_time = 0;
+    int candidate = 0;
+    while (solution.size() != this->job_count) {
+        for (int i = 0; i < waiting_count;) {
+            int id = waiting[i];
+
+            if (release_time[id] <= elapsed_time) {
+                ready[id / 64] |= std::uint64_t{1} << (id % 64);
+                waiting[i] = waiting[--waiting_count];
+            } else {
+                i++;
+            }
+        }
+
+        const float* choice_row = &this->choice_points[candidate * stride];
+        int candidate_count = 0;
+        for (int word = 0; word < words; word++) {
+            for (auto bits = ready[word]; bits != 0; bits &= bits - 1) {
+                int id = word * 64 + std::countr_zero(bits);
+                candidate_list[candidate_count++] = {id, choice_row[id]};
+            }
+        }
+
+        // every remaining job is still waiting on a precedence delay, so the delays are relaxed
+        if (candidate_count == 0) {
+            Stats::add(Stats::delay_relaxations);
+
+            for (int i = 0; i < waiting_count; i++) {
+                candidate_list[candidate_count++] = {waiting[i], choice_row[waiting[i]]};
+            }
+        }
+
+        int new_candidate = Greedy::pickCandidate(std::span{candidate_list.data(), static_cast<std::size_t>(candidate_count)}, alpha, generator);
+
+        if (ready[new_candidate / 64] & (std::uint64_t{1} << (new_candidate % 64))) {
+            ready[new_candidate / 64] &= ~(std::uint64_t{1} << (new_candidate % 64));
+        } else {
+            // keeps the order of the others, as std::erase does
+            auto waiting_end = std::remove(waiting.begin(), waiting.begin() + waiting_count, new_candidate);
+            waiting_count = waiting_end - waiting.begin();
+        }
+
+        elapsed_time += this->setup_time[candidate * stride + new_candidate] + this->processing_time[new_candidate];
+
+        for (int dependent : this->dependency_graph.getDependents(new_candidate)) {
+            release_time[dependent] = std::max(release_time[dependent], elapsed_time + this->precedence_delay[new_candidate * stride + dependent]);
+
+            if (--remaining_dependencies[dependent] == 0) {
+                waiting[waiting_count++] = dependent;
+            }
+        }
+
+        solution.push_back(new_candidate);
+        candidate = new_candidate;
+    }
+
+    return solution;
+}
+
+// ScheduleEvaluator::evaluate with the dependencies of a job as a bitset, so checking that they're
+// placed is a few word operations and only the placed ones are walked for their delays
+template<int stride>
+ScheduleEvaluator::Evaluation FixedKernels<stride>::evaluate(std::span<const int> schedule) {
+    Stats::add(Stats::validity_checks);
+
+    if (schedule.size() != this->job_count) {
+        Stats::add(Stats::validity_rejections);
+        return {0, false};
+    }
+
+    Bits placed{};
+    std::array<int, stride> finish_time;
+
+    bool valid = true;
+    int previous_id = 0;
+    int elapsed_time = 0;
+    for (int id : schedule) {
+        if (id < 1 || id > this->job_count || (placed[id / 64] & (std::uint64_t{1} << (id % 64)))) {
+            Stats::add(Stats::validity_rejections);
+            return {0, false};
+        }
+
+        for (int word = 0; word < words; word++) {
+            if (this->dependencies[id][word] & ~placed[word]) {
+                valid = false;
+            }
+
+            for (auto bits = this->dependencies[id][word] & placed[word]; bits != 0; bits &= bits - 1) {
+                int dependency = word * 64 + std::countr_zero(bits);
+                if (elapsed_time - finish_time[dependency] < this->precedence_delay[dependency * stride + id]) {
+                    valid = false;
+                }
+            }
+        }
+
+        elapsed_time += this->setup_time[previous_id * stride + id] + this->processing_time[id];
+        placed[id / 64] |= std::uint64_t{1} << (id % 64);
+        finish_time[id] = elapsed_time;
+
+        previous_id = id;
+    }
+
+    if (!valid) {
+        Stats::add(Stats::validity_rejections);
+    }
+
+    // calculateTimespan charges the first job's processing time twice
+    return {elapsed_time + this->processing_time[schedule[0]], valid};
+}
+
+class DynamicKernels final : public SizedKernels {
+    public:
+        DynamicKernels(const DependencyGraph& dependency_graph):
+            dependency_graph{dependency_graph},
+            schedule_evaluator{dependency_graph} {}
+
+        int getMaxJobCount() const override {
+            return 0;
+        }
+
+        std::vector<int> construct(float alpha, unsigned int seed) override {
+            return Greedy::greedyRandomizedAdaptiveProcedure(this->dependency_graph, alpha, seed);
+        }
+
+        ScheduleEvaluator::Evaluation evaluate(std::span<const int> schedule) override {
+            return this->schedule_evaluator.evaluate(schedule);
+        }
+
+    private:
+        const DependencyGraph& dependency_graph;
+        ScheduleEvaluator schedule_evaluator;
+};
+
+std::unique_ptr<SizedKernels> SizedKernels::make(const DependencyGraph& dependency_graph) {
+    int job_count = dependency_graph.getJobCount();
+
+    if (job_count < 16) {
+        return std::make_unique<FixedKernels<16>>(dependency_graph);
+    }
+    if (job_count < 32) {
+        return std::make_unique<FixedKernels<32>>(dependency_graph);
+    }
+    if (job_count < 64) {
+        return std::make_unique<FixedKernels<64>>(dependency_graph);
+    }
+    if (job_count < 128) {
+        return std::make_unique<FixedKernels<128>>(dependency_graph);
+    }
+
+    return std::make_unique<DynamicKernels>(dependency_graph);
+}
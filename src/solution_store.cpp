@@ -0,0 +1,125 @@
+#include "solution_store.hpp"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+// an exclusive flock on a file, released when it goes out of scope
+class FileLock {
+    public:
+        FileLock(const std::filesystem::path& lock_file_path) {
+            this->file_descriptor = open(lock_file_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (this->file_descriptor == -1) {
+                throw std::runtime_error{"Couldn't open " + lock_file_path.string() + ".\n"};
+            }
+
+            while (flock(this->file_descriptor, LOCK_EX) == -1) {
+                if (errno != EINTR) {
+                    close(this->file_descriptor);
+                    throw std::runtime_error{"Couldn't lock " + lock_file_path.string() + ".\n"};
+                }
+            }
+        }
+
+        FileLock(const FileLock&) = delete;
+        FileLock& operator=(const FileLock&) = delete;
+
+        ~FileLock() {
+            close(this->file_descriptor);
+        }
+
+    private:
+        int file_descriptor;
+};
+
+SolutionStore::SolutionStore(std::filesystem::path directory): directory{std::move(directory)} {
+    std::filesystem::create_directories(this->directory);
+}
+
+std::optional<SolutionStore::Record> SolutionStore::find(std::uint64_t content_hash) const {
+    std::ifstream file_reader{this->recordPath(content_hash)};
+    if (!file_reader) {
+        return std::nullopt;
+    }
+
+    Record record{};
+    bool has_timespan = false;
+    for (std::string line; std::getline(file_reader, line);) {
+        std::istringstream fields{line};
+        std::string key;
+        fields >> key;
+
+        if (key == "timespan") {
+            has_timespan = static_cast<bool>(fields >> record.timespan);
+        } else if (key == "seed") {
+            fields >> record.seed;
+        } else if (key == "parameters") {
+            std::getline(fields >> std::ws, record.parameters);
+        } else if (key == "schedule") {
+            for (int id; fields >> id;) {
+                record.schedule.push_back(id);
+            }
+        }
+    }
+
+    if (!has_timespan || record.schedule.empty()) {
+        return std::nullopt;
+    }
+
+    return record;
+}
+
+bool SolutionStore::offer(std::uint64_t content_hash, const Record& record, const std::function<bool(const Record&)>& check) {
+    auto record_path = this->recordPath(content_hash);
+
+    auto lock_file_path = record_path;
+    lock_file_path.replace_extension(".lock");
+    FileLock lock{lock_file_path};
+
+    auto stored = this->find(content_hash);
+    if (stored && check(*stored) && stored->timespan <= record.timespan) {
+        return false;
+    }
+
+    // written under a name of its own and renamed, as DependencyGraph::load does with its cache
+    auto temporary_file_path = record_path;
+    temporary_file_path += "." + std::to_string(getpid()) + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file_writer{temporary_file_path};
+        file_writer << "timespan " << record.timespan << "\n"
+                    << "seed " << record.seed << "\n"
+                    << "parameters " << record.parameters << "\n"
+                    << "schedule";
+        for (int id : record.schedule) {
+            file_writer << " " << id;
+        }
+        file_writer << "\n";
+
+        if (!file_writer.flush()) {
+            std::error_code error;
+            std::filesystem::remove(temporary_file_path, error);
+            throw std::runtime_error{"Couldn't write " + temporary_file_path.string() + ".\n"};
+        }
+    }
+    std::filesystem::rename(temporary_file_path, record_path);
+
+    return true;
+}
+
+std::filesystem::path SolutionStore::recordPath(std::uint64_t content_hash) const {
+    constexpr char digits[] = "0123456789abcdef";
+
+    std::string name(16, '0');
+    for (int i = 15; i >= 0; i--, content_hash >>= 4) {
+        name[i] = digits[content_hash & 0xf];
+    }
+
+    return this->directory / (name + ".txt");
+}
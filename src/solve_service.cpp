@@ -0,0 +1,277 @@
+#include "solve_service.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dependency_graph.hpp"
+#include "lower_bound.hpp"
+
+// Line by line over a descriptor, for stdin and sockets alike.
+class LineReader {
+    public:
+        LineReader(int file_descriptor): file_descriptor{file_descriptor}, buffer(1 << 16), begin{0}, end{0} {}
+
+        // false once the input ended; a last line without a newline still counts
+        bool next(std::string& line) {
+            line.clear();
+
+            while (true) {
+                for (std::size_t i = this->begin; i < this->end; i++) {
+                    if (this->buffer[i] == '\n') {
+                        line.append(&this->buffer[this->begin], i - this->begin);
+                        this->begin = i + 1;
+
+                        if (!line.empty() && line.back() == '\r') {
+                            line.pop_back();
+                        }
+                        return true;
+                    }
+                }
+
+                line.append(&this->buffer[this->begin], this->end - this->begin);
+                this->begin = 0;
+                this->end = 0;
+
+                ssize_t bytes_read = read(this->file_descriptor, this->buffer.data(), this->buffer.size());
+                if (bytes_read < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (bytes_read <= 0) {
+                    return !line.empty();
+                }
+
+                this->end = bytes_read;
+            }
+        }
+
+    private:
+        int file_descriptor;
+        std::vector<char> buffer;
+        std::size_t begin;
+        std::size_t end;
+};
+
+// What the requests of one input stream share: where their answers go, and how many are still out.
+struct Connection {
+    int output_fd;
+    std::mutex output_mutex;
+
+    std::mutex pending_mutex;
+    std::condition_variable pending_finished;
+    int pending_requests = 0;
+
+    void writeLine(const std::string& line) {
+        std::lock_guard lock{this->output_mutex};
+
+        // a client that went away only loses its answers
+        for (std::size_t written = 0; written < line.size();) {
+            ssize_t bytes_written = write(this->output_fd, line.data() + written, line.size() - written);
+            if (bytes_written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (bytes_written <= 0) {
+                return;
+            }
+
+            written += bytes_written;
+        }
+    }
+};
+
+struct Request {
+    long long number;
+    std::string source;
+    bool inline_instance = false;
+    std::string instance_text;
+    Solver::Options options;
+};
+
+// error messages in this repo end with a newline of their own
+std::string errorLine(long long number, const std::string& source, std::string message) {
+    while (!message.empty() && message.back() == '\n') {
+        message.pop_back();
+    }
+
+    return std::to_string(number) + " " + source + ": error " + message + "\n";
+}
+
+SolveService::SolveService(const Options& options):
+    thread_pool{options.workers},
+    queue_capacity{options.queue_capacity > 0 ? options.queue_capacity : 2 * options.workers},
+    default_options{options.solver},
+    default_iterations_given{options.iterations_given},
+    queued_requests{0} {}
+
+void SolveService::serve(int input_fd, int output_fd) {
+    auto connection = std::make_shared<Connection>();
+    connection->output_fd = output_fd;
+
+    LineReader reader{input_fd};
+    std::string line;
+    long long request_number = 0;
+    while (reader.next(line)) {
+        std::istringstream tokens{line};
+        std::string source;
+        if (!(tokens >> source) || source.starts_with("#")) {
+            continue;
+        }
+
+        Request request;
+        request.number = ++request_number;
+        request.source = source;
+        request.options = this->default_options;
+
+        if (source == "inline") {
+            request.inline_instance = true;
+
+            bool ended = false;
+            std::string instance_line;
+            while (reader.next(instance_line)) {
+                if (instance_line == "end") {
+                    ended = true;
+                    break;
+                }
+
+                request.instance_text += instance_line;
+                request.instance_text += '\n';
+            }
+
+            if (!ended) {
+                connection->writeLine(errorLine(request.number, source, "input ended before the instance's \"end\" line"));
+                break;
+            }
+        }
+
+        try {
+            bool iterations_given = this->default_iterations_given;
+            for (std::string option, value; tokens >> option;) {
+                if (!(tokens >> value)) {
+                    throw std::invalid_argument{"Missing value for " + option + ".\n"};
+                }
+                if (!Solver::parseOption(request.options, option, value, iterations_given)) {
+                    throw std::invalid_argument{"Unknown option " + option + ".\n"};
+                }
+            }
+
+            Solver::applyTimeLimit(request.options, iterations_given);
+
+            // parseOption turns these down on a request line, but the defaults come from whoever
+            // built the service, and a run with no iteration or no worker has no schedule to answer with
+            if (request.options.iterations < 1 || request.options.threads < 1) {
+                throw std::invalid_argument{"A request needs at least 1 iteration and 1 thread.\n"};
+            }
+        } catch (const std::exception& exception) {
+            connection->writeLine(errorLine(request.number, source, exception.what()));
+            continue;
+        }
+
+        // backpressure: nothing more is read while the queue is full
+        {
+            std::unique_lock lock{this->queue_mutex};
+            this->queue_changed.wait(lock, [this]() {
+                return this->queued_requests < this->queue_capacity;
+            });
+            this->queued_requests++;
+        }
+        {
+            std::lock_guard lock{connection->pending_mutex};
+            connection->pending_requests++;
+        }
+
+        this->thread_pool.submit([this, connection, request = std::move(request)]() {
+            std::string answer;
+            try {
+                auto dependency_graph = request.inline_instance
+                                            ? DependencyGraph::fromText(request.instance_text, request.source)
+                                            : DependencyGraph::load(request.source);
+
+                auto start_time = std::chrono::steady_clock::now();
+                auto result = Solver::multiStart(dependency_graph, request.options, this->thread_pool);
+                auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
+
+                bool optimal = result.valid && result.timespan <= result.lower_bound;
+
+                std::ostringstream output;
+                output << request.number << " " << request.source << ": "
+                       << result.timespan << (result.valid ? "" : " (invalid)") << (optimal ? " (optimal)" : "")
+                       << " (gap " << std::fixed << std::setprecision(2) << LowerBound::gap(result.timespan, result.lower_bound) << "%)"
+                       << " (" << duration.count() << "ms) (seed " << request.options.seed << "):";
+                for (auto value : result.schedule) {
+                    output << " " << value;
+                }
+                output << "\n";
+
+                answer = output.str();
+            } catch (const std::exception& exception) {
+                answer = errorLine(request.number, request.source, exception.what());
+            }
+
+            connection->writeLine(answer);
+
+            {
+                std::lock_guard lock{this->queue_mutex};
+                this->queued_requests--;
+            }
+            this->queue_changed.notify_one();
+
+            {
+                std::lock_guard lock{connection->pending_mutex};
+                connection->pending_requests--;
+            }
+            connection->pending_finished.notify_all();
+        });
+    }
+
+    std::unique_lock lock{connection->pending_mutex};
+    connection->pending_finished.wait(lock, [&]() {
+        return connection->pending_requests == 0;
+    });
+}
+
+void SolveService::listen(const std::filesystem::path& socket_path) {
+    // writing to a client that hung up would otherwise end the whole service
+    std::signal(SIGPIPE, SIG_IGN);
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.string().size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument{"Socket path " + socket_path.string() + " is too long.\n"};
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd == -1) {
+        throw std::runtime_error{"Couldn't create a socket.\n"};
+    }
+
+    std::filesystem::remove(socket_path);
+    if (bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 || ::listen(listen_fd, 16) == -1) {
+        close(listen_fd);
+        throw std::runtime_error{"Couldn't listen on " + socket_path.string() + ".\n"};
+    }
+
+    while (true) {
+        int connection_fd = accept(listen_fd, nullptr, nullptr);
+        if (connection_fd == -1) {
+            continue;
+        }
+
+        std::thread{[this, connection_fd]() {
+            this->serve(connection_fd, connection_fd);
+            close(connection_fd);
+        }}.detach();
+    }
+}
@@ -0,0 +1,329 @@
+#include "solver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
+
+#include "best_solution.hpp"
+#include "candidate_lists.hpp"
+#include "elite_pool.hpp"
+#include "greedy.hpp"
+#include "local_search.hpp"
+#include "lower_bound.hpp"
+#include "move_evaluator.hpp"
+#include "reactive_alpha.hpp"
+#include "schedule_evaluator.hpp"
+#include "sized_kernels.hpp"
+#include "solution_store.hpp"
+#include "tabu_search.hpp"
+#include "thread_pool.hpp"
+
+// the construction seed of an iteration depends on nothing but the run's seed and the iteration,
+// the trailing 1 keeps it apart from the worker streams split off (seed, worker)
+unsigned int constructionSeed(unsigned int seed, int iteration) {
+    std::seed_seq seed_sequence{seed, static_cast<unsigned int>(iteration), 1u};
+    unsigned int construction_seed;
+    seed_sequence.generate(&construction_seed, &construction_seed + 1);
+
+    return construction_seed;
+}
+
+// the options that shape a run, as parseOption takes them, for the solution store's records
+std::string describeOptions(const Solver::Options& options) {
+    std::string description = "--iterations " + std::to_string(options.iterations)
+                            + " --threads " + std::to_string(options.threads)
+                            + " --alpha " + (options.reactive_alpha ? std::string{"reactive"} : std::to_string(options.alpha))
+                            + " --perturbations " + std::to_string(options.perturbations)
+                            + " --elite " + std::to_string(options.elite_size)
+                            + " --granular " + std::to_string(options.granular_neighbors)
+                            + " --tabu " + std::to_string(options.tabu_iterations)
+                            + " --time-limit " + std::to_string(options.time_limit.count());
+
+    return options.parallel_neighborhoods ? description + " --parallel-neighborhoods" : description;
+}
+
+Solver::Result Solver::multiStart(const DependencyGraph& dependency_graph, const Options& options) {
+    ThreadPool thread_pool{options.threads};
+
+    return Solver::multiStart(dependency_graph, options, thread_pool);
+}
+
+Solver::Result Solver::multiStart(const DependencyGraph& dependency_graph, const Options& options, ThreadPool& thread_pool) {
+    BestSolution best_solution{dependency_graph.getJobCount()};
+
+    // a parallel descent takes the whole pool for itself, and a worker with no iteration of its own
+    // would have nothing to do
+    int worker_count = options.parallel_neighborhoods ? 1 : std::min(options.threads, options.iterations);
+
+    // one slot per worker, merged once every worker is done
+    std::vector<Result> worker_statistics(worker_count);
+
+    // a few jobs out of every ten, enough to leave the start's basin without losing its structure
+    int perturbation_strength = std::clamp(dependency_graph.getJobCount() / 10, 2, 10);
+
+    // the same for how far apart elite schedules have to be
+    int elite_distance = std::clamp(dependency_graph.getJobCount() / 10, 2, 10);
+
+    // shared by the workers, only read during the run
+    std::optional<CandidateLists> candidate_lists;
+    if (options.granular_neighbors > 0) {
+        candidate_lists.emplace(dependency_graph, options.granular_neighbors);
+    }
+
+    // a stored schedule replaces the first construction of worker 0, once it proved valid for this
+    // instance and to have the timespan it was stored with
+    auto holds = [&](const SolutionStore::Record& record) {
+        return record.schedule.size() == dependency_graph.getJobCount()
+            && Greedy::checkScheduleValidity(dependency_graph, record.schedule)
+            && Greedy::calculateTimespan(dependency_graph, record.schedule) == record.timespan;
+    };
+
+    std::optional<SolutionStore> solution_store;
+    std::vector<int> warm_start;
+    if (!options.solution_store_path.empty()) {
+        solution_store.emplace(options.solution_store_path);
+
+        auto record = solution_store->find(dependency_graph.getContentHash());
+        if (record && holds(*record)) {
+            warm_start = std::move(record->schedule);
+        }
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    auto deadline = start_time + options.time_limit;
+    bool time_limited = options.time_limit.count() > 0;
+
+    // the first iteration whose schedule reached the bound; the ones after it are skipped and the ones
+    // before it all still run, since one of them may reach the bound too and win the tie, so where the
+    // run stops doesn't depend on thread timing
+    int lower_bound = LowerBound::compute(dependency_graph).value;
+    std::atomic<int> lower_bound_iteration{std::numeric_limits<int>::max()};
+
+    // new bests are rare, so the trace can afford a lock
+    std::ofstream trace_writer;
+    std::mutex trace_mutex;
+    if (!options.trace_file_path.empty()) {
+        trace_writer.open(options.trace_file_path);
+        trace_writer << "elapsed_ms,timespan,valid,iteration\n";
+    }
+
+    thread_pool.parallelFor(worker_count, [&](int worker) {
+        std::seed_seq seed_sequence{options.seed, static_cast<unsigned int>(worker)};
+        std::mt19937 seed_stream{seed_sequence};
+        auto& statistics = worker_statistics[worker];
+
+        // reused by every iteration, so the local search itself allocates nothing after the first one
+        MoveEvaluator move_evaluator{dependency_graph};
+        auto neighborhoods = candidate_lists ? LocalSearch::granularNeighborhoods(*candidate_lists) : LocalSearch::defaultNeighborhoods();
+        std::optional<LocalSearch::ParallelDescent> parallel_descent;
+        if (options.parallel_neighborhoods) {
+            parallel_descent.emplace(dependency_graph, thread_pool);
+        }
+        auto kernels = SizedKernels::make(dependency_graph);
+        TabuSearch tabu_search{dependency_graph.getJobCount()};
+        auto tabu_deadline = time_limited ? deadline : std::chrono::steady_clock::time_point::max();
+
+        auto descend = [&]() {
+            if (parallel_descent) {
+                parallel_descent->descend(move_evaluator, neighborhoods, statistics.moves_evaluated);
+            } else {
+                LocalSearch::descend(move_evaluator, neighborhoods, statistics.moves_evaluated);
+            }
+        };
+
+        // one per worker rather than shared, so the result still doesn't depend on thread timing
+        ElitePool elite_pool{options.elite_size, elite_distance};
+        Result relinked;
+        ReactiveAlpha reactive_alpha;
+        int alpha_index = 0;
+
+        Result candidate;
+        Result incumbent;
+        int perturbations_left = 0;
+
+        // the step stops at options.iterations rather than past it, which can be INT_MAX under a time limit
+        auto next_iteration = [&](int iteration) {
+            return iteration < options.iterations - worker_count ? iteration + worker_count : options.iterations;
+        };
+
+        // iteration 0 always runs, so there is always something to return
+        for (int iteration = worker; iteration < options.iterations; iteration = next_iteration(iteration)) {
+            auto iteration_start_time = std::chrono::steady_clock::now();
+            if (time_limited && iteration != worker && iteration_start_time >= deadline) {
+                break;
+            }
+
+            if (iteration > lower_bound_iteration.load(std::memory_order_relaxed)) {
+                break;
+            }
+
+            bool restart = perturbations_left == 0;
+            float alpha = options.alpha;
+            if (restart && options.reactive_alpha) {
+                alpha_index = reactive_alpha.draw(seed_stream);
+                alpha = ReactiveAlpha::values[alpha_index];
+            }
+
+            bool warm_started = iteration == 0 && !warm_start.empty();
+            auto initial_schedule = warm_started ? warm_start
+                                  : restart      ? kernels->construct(alpha, constructionSeed(options.seed, iteration))
+                                                 : LocalSearch::perturb(dependency_graph, incumbent.schedule, perturbation_strength, seed_stream);
+            perturbations_left = restart ? options.perturbations : perturbations_left - 1;
+
+            auto construction_end_time = std::chrono::steady_clock::now();
+            move_evaluator.load(initial_schedule);
+            descend();
+
+            // the tabu search goes on from the local optimum and its best schedule gets the other neighborhoods'
+            // descent; a start the descent couldn't repair is left to the next one, since scoring moves from a
+            // schedule that breaks arcs means counting the arcs of nearly all of them
+            if (options.tabu_iterations > 0 && move_evaluator.getViolationCount() == 0) {
+                tabu_search.run(move_evaluator, options.tabu_iterations, tabu_deadline, seed_stream, statistics.moves_evaluated);
+                descend();
+            }
+
+            auto evaluation = kernels->evaluate(move_evaluator.getSchedule());
+            candidate.schedule = move_evaluator.getSchedule();
+            candidate.timespan = evaluation.timespan;
+            candidate.valid = evaluation.valid;
+
+            // what the construction led to, before relinking mixes in other starts
+            if (restart && options.reactive_alpha && !warm_started) {
+                reactive_alpha.record(alpha_index, candidate.timespan, candidate.valid);
+            }
+
+            if (options.elite_size > 0) {
+                if (!elite_pool.empty()) {
+                    const auto& member = elite_pool.get(std::uniform_int_distribution<>{0, elite_pool.size() - 1}(seed_stream));
+
+                    // the better end's surroundings are the more promising ones, so the walk leaves from there
+                    bool from_member = isBetter(member, candidate);
+                    if (from_member) {
+                        move_evaluator.load(member.schedule);
+                    }
+
+                    if (LocalSearch::relink(move_evaluator, from_member ? candidate.schedule : member.schedule, statistics.moves_evaluated)) {
+                        descend();
+
+                        auto relinked_evaluation = kernels->evaluate(move_evaluator.getSchedule());
+                        relinked.schedule = move_evaluator.getSchedule();
+                        relinked.timespan = relinked_evaluation.timespan;
+                        relinked.valid = relinked_evaluation.valid;
+
+                        if (isBetter(relinked, candidate)) {
+                            std::swap(candidate, relinked);
+                        }
+                    }
+                }
+
+                elite_pool.offer(candidate.schedule, candidate.timespan, candidate.valid);
+            }
+            auto end_time = std::chrono::steady_clock::now();
+
+            statistics.construction_time += construction_end_time - iteration_start_time;
+            statistics.local_search_time += end_time - construction_end_time;
+
+            if (restart || isBetter(candidate, incumbent)) {
+                incumbent = candidate;
+            }
+
+            if (options.stop_at_lower_bound && candidate.valid && candidate.timespan <= lower_bound) {
+                int first_iteration = lower_bound_iteration.load(std::memory_order_relaxed);
+                while (iteration < first_iteration && !lower_bound_iteration.compare_exchange_weak(first_iteration, iteration, std::memory_order_relaxed)) {}
+            }
+
+            if (!best_solution.offer(candidate.schedule, candidate.timespan, candidate.valid, iteration)) {
+                continue;
+            }
+
+            if (trace_writer.is_open()) {
+                std::lock_guard lock{trace_mutex};
+                trace_writer << std::chrono::duration<double, std::milli>(end_time - start_time).count() << ","
+                             << candidate.timespan << "," << candidate.valid << "," << iteration << "\n";
+            }
+        }
+    });
+
+    Result result{best_solution.getSchedule(), best_solution.getTimespan(), best_solution.isValid(), lower_bound};
+    for (const auto& statistics : worker_statistics) {
+        result.construction_time += statistics.construction_time;
+        result.local_search_time += statistics.local_search_time;
+        result.moves_evaluated += statistics.moves_evaluated;
+    }
+
+    if (solution_store && result.valid) {
+        solution_store->offer(dependency_graph.getContentHash(), {result.schedule, result.timespan, options.seed, describeOptions(options)}, holds);
+    }
+
+    return result;
+}
+
+bool Solver::parseOption(Options& options, std::string_view name, const std::string& value, bool& iterations_given) {
+    if (name == "--iterations") {
+        options.iterations = std::stoi(value);
+        iterations_given = true;
+        if (options.iterations < 1) {
+            throw std::invalid_argument{"--iterations takes at least 1.\n"};
+        }
+    } else if (name == "--threads") {
+        options.threads = std::stoi(value);
+        if (options.threads < 1) {
+            throw std::invalid_argument{"--threads takes at least 1.\n"};
+        }
+    } else if (name == "--seed") {
+        options.seed = std::stoul(value);
+    } else if (name == "--alpha") {
+        options.reactive_alpha = value == "reactive";
+        if (!options.reactive_alpha) {
+            options.alpha = std::stof(value);
+            if (!std::isfinite(options.alpha) || options.alpha < 0 || options.alpha > 1) {
+                throw std::invalid_argument{"--alpha takes reactive or a value from 0 to 1.\n"};
+            }
+        }
+    } else if (name == "--perturbations") {
+        options.perturbations = std::stoi(value);
+        if (options.perturbations < 0) {
+            throw std::invalid_argument{"--perturbations takes at least 0.\n"};
+        }
+    } else if (name == "--elite") {
+        options.elite_size = std::stoi(value);
+        if (options.elite_size < 0) {
+            throw std::invalid_argument{"--elite takes at least 0.\n"};
+        }
+    } else if (name == "--tabu") {
+        options.tabu_iterations = std::stoi(value);
+        if (options.tabu_iterations < 0) {
+            throw std::invalid_argument{"--tabu takes at least 0.\n"};
+        }
+    } else if (name == "--granular") {
+        options.granular_neighbors = std::stoi(value);
+        if (options.granular_neighbors < 0) {
+            throw std::invalid_argument{"--granular takes at least 0.\n"};
+        }
+    } else if (name == "--time-limit") {
+        options.time_limit = std::chrono::milliseconds{std::stoll(value)};
+        if (options.time_limit.count() < 0) {
+            throw std::invalid_argument{"--time-limit takes at least 0.\n"};
+        }
+    } else if (name == "--trace") {
+        options.trace_file_path = value;
+    } else if (name == "--store") {
+        options.solution_store_path = value;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+void Solver::applyTimeLimit(Options& options, bool iterations_given) {
+    if (options.time_limit.count() > 0 && !iterations_given) {
+        options.iterations = std::numeric_limits<int>::max();
+    }
+}
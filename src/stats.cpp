@@ -0,0 +1,243 @@
+#include "stats.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <new>
+#include <string>
+
+constexpr std::array<const char *, Stats::counter_count> counter_names{
+    "swap_moves_generated",
+    "swap_moves_feasible",
+    "swap_moves_improving",
+    "insert_moves_generated",
+    "insert_moves_feasible",
+    "insert_moves_improving",
+    "block_moves_generated",
+    "block_moves_feasible",
+    "block_moves_improving",
+    "reversal_moves_generated",
+    "reversal_moves_feasible",
+    "reversal_moves_improving",
+    "tabu_iterations",
+    "tabu_revisits",
+    "validity_checks",
+    "validity_rejections",
+    "constructions",
+    "delay_relaxations",
+    "binary_cache_hits",
+    "text_parses",
+    "allocations",
+    "allocated_bytes",
+};
+
+constexpr std::array<const char *, Stats::phase_count> phase_names{
+    "text_parse",
+    "binary_load",
+    "construction",
+    "swap_phase",
+    "insert_phase",
+    "block_phase",
+    "reversal_phase",
+    "tabu_phase",
+};
+
+#ifdef SCHEDULING_STATS
+// Live slots are chained in a list. When a thread exits, its counts are folded into the retired
+// slot and its node goes on a free list for the next thread, so a process that keeps starting
+// threads holds no more nodes than it ever had threads at once. Nodes come from malloc rather
+// than operator new, so registering from inside operator new below doesn't recurse, and the
+// list heads need no construction, so that works during static initialization too.
+struct SlotNode {
+    Stats::Slot slot;
+    SlotNode *next;
+};
+
+std::mutex slots_mutex;
+SlotNode *slots = nullptr;
+SlotNode *free_slots = nullptr;
+
+// what exited threads counted, and what they allocate after their slot was retired
+Stats::Slot retired_slot;
+
+// folds the thread's slot away when the thread exits; anything the thread counts after that goes
+// straight into the retired slot
+struct SlotOwner {
+    SlotNode *node = nullptr;
+
+    ~SlotOwner() {
+        if (this->node == nullptr) {
+            return;
+        }
+
+        std::lock_guard lock{slots_mutex};
+        for (int i = 0; i < Stats::counter_count; i++) {
+            retired_slot.counters[i].fetch_add(this->node->slot.counters[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        for (int i = 0; i < Stats::phase_count; i++) {
+            retired_slot.phase_nanoseconds[i].fetch_add(this->node->slot.phase_nanoseconds[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        auto **link = &slots;
+        while (*link != this->node) {
+            link = &(*link)->next;
+        }
+        *link = this->node->next;
+        this->node->next = free_slots;
+        free_slots = this->node;
+
+        Stats::local_slot = &retired_slot;
+    }
+};
+
+thread_local SlotOwner slot_owner;
+
+Stats::Slot *Stats::registerSlot() {
+    SlotNode *node;
+    {
+        std::lock_guard lock{slots_mutex};
+        node = free_slots;
+        if (node != nullptr) {
+            free_slots = node->next;
+        }
+    }
+
+    if (node == nullptr) {
+        void *memory = std::malloc(sizeof(SlotNode));
+        if (memory == nullptr) {
+            throw std::bad_alloc{};
+        }
+        node = new (memory) SlotNode{};
+    }
+
+    {
+        std::lock_guard lock{slots_mutex};
+        node->next = slots;
+        slots = node;
+    }
+    slot_owner.node = node;
+
+    return &node->slot;
+}
+
+// The replaced operator new registers the thread's slot on its first allocation, so every
+// allocation is counted. The add is atomic because an exiting thread's slot is the shared retired one.
+void *countedAllocation(std::size_t size) {
+    if (Stats::local_slot == nullptr) {
+        Stats::local_slot = Stats::registerSlot();
+    }
+
+    Stats::local_slot->counters[Stats::allocations].fetch_add(1, std::memory_order_relaxed);
+    Stats::local_slot->counters[Stats::allocated_bytes].fetch_add(size, std::memory_order_relaxed);
+
+    if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void *operator new(std::size_t size) {
+    return countedAllocation(size);
+}
+
+void *operator new[](std::size_t size) {
+    return countedAllocation(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+Stats::Report Stats::collect() {
+    std::lock_guard lock{slots_mutex};
+
+    Report report;
+    for (int i = 0; i < counter_count; i++) {
+        report.counters[i] = retired_slot.counters[i].load(std::memory_order_relaxed);
+    }
+    for (int i = 0; i < phase_count; i++) {
+        report.phase_times[i] = std::chrono::nanoseconds{retired_slot.phase_nanoseconds[i].load(std::memory_order_relaxed)};
+    }
+
+    for (const auto *node = slots; node != nullptr; node = node->next) {
+        for (int i = 0; i < counter_count; i++) {
+            report.counters[i] += node->slot.counters[i].load(std::memory_order_relaxed);
+        }
+
+        for (int i = 0; i < phase_count; i++) {
+            report.phase_times[i] += std::chrono::nanoseconds{node->slot.phase_nanoseconds[i].load(std::memory_order_relaxed)};
+        }
+    }
+
+    return report;
+}
+
+void Stats::reset() {
+    std::lock_guard lock{slots_mutex};
+
+    auto clear = [](Slot& slot) {
+        for (auto& counter : slot.counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+
+        for (auto& phase_nanoseconds : slot.phase_nanoseconds) {
+            phase_nanoseconds.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    clear(retired_slot);
+    for (auto *node = slots; node != nullptr; node = node->next) {
+        clear(node->slot);
+    }
+}
+#else
+Stats::Report Stats::collect() {
+    return {};
+}
+
+void Stats::reset() {}
+#endif
+
+void Stats::print(std::ostream& output, const Report& report) {
+    if (!enabled) {
+        output << "stats: built without SCHEDULING_STATS\n";
+
+        return;
+    }
+
+    for (int i = 0; i < counter_count; i++) {
+        output << std::left << std::setw(24) << counter_names[i] << report.counters[i] << "\n";
+    }
+
+    for (int i = 0; i < phase_count; i++) {
+        output << std::left << std::setw(24) << (std::string{phase_names[i]} + "_ms") << std::fixed << std::setprecision(3)
+               << std::chrono::duration<double, std::milli>(report.phase_times[i]).count() << "\n";
+    }
+}
+
+void Stats::printJson(std::ostream& output, const Report& report) {
+    output << "{\"enabled\": " << (enabled ? "true" : "false") << ", \"counters\": {";
+    for (int i = 0; i < counter_count; i++) {
+        output << (i == 0 ? "" : ", ") << "\"" << counter_names[i] << "\": " << report.counters[i];
+    }
+
+    output << "}, \"phases_ms\": {" << std::fixed << std::setprecision(3);
+    for (int i = 0; i < phase_count; i++) {
+        output << (i == 0 ? "" : ", ") << "\"" << phase_names[i] << "\": "
+               << std::chrono::duration<double, std::milli>(report.phase_times[i]).count();
+    }
+    output << "}}\n";
+}
@@ -0,0 +1,182 @@
+#include "tabu_search.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+#include "stats.hpp"
+
+TabuSearch::TabuSearch(int job_count):
+    job_count{job_count},
+    position_stride{(job_count + max_position_slots - 1) / max_position_slots},
+    position_slots{std::min(job_count, max_position_slots)},
+    tabu_until(static_cast<std::size_t>(job_count) * std::min(job_count, max_position_slots), 0),
+    iteration{0},
+    visited(visited_slots, 0),
+    deltas(job_count) {}
+
+void TabuSearch::run(
+    MoveEvaluator& move_evaluator, int iterations, std::chrono::steady_clock::time_point deadline,
+    std::mt19937& generator, long long& moves_evaluated
+) {
+    Stats::ScopedTimer timer{Stats::tabu_phase};
+
+    const auto& schedule = move_evaluator.getSchedule();
+    int job_count = this->job_count;
+
+    std::uint64_t hash = 0;
+    for (int k = 0; k < job_count; k++) {
+        hash ^= key(schedule[k], k);
+    }
+    this->markVisited(hash);
+
+    this->best_schedule = schedule;
+    int best_violations = move_evaluator.getViolationCount();
+    int best_timespan = move_evaluator.getTimespan();
+
+    // long enough to leave a local optimum behind, drawn per move so the search doesn't settle into a period
+    int tenure = std::clamp(job_count / 10, 2, 20);
+    std::uniform_int_distribution<> tenure_distribution{tenure, tenure + tenure / 2};
+
+    for (int step = 0; step < iterations; step++) {
+        // the clock is cheap next to a full scan, but not free
+        if (step % 16 == 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+
+        this->iteration++;
+        Stats::add(Stats::tabu_iterations);
+
+        int timespan_now = move_evaluator.getTimespan();
+        Move best_swap;
+        Move best_insert;
+
+        // the arcs and the hash are only looked at for moves that could still win
+        auto consider = [&](int i, int j, int delta, bool insert, Move& best) {
+            if (best.violations == 0 && delta >= best.timespan_delta) {
+                return;
+            }
+
+            bool tabu = insert ? this->isTabu(schedule[i], j) : this->isTabu(schedule[i], j) || this->isTabu(schedule[j], i);
+            bool could_aspire = best_violations > 0 || timespan_now + delta < best_timespan;
+            if (tabu && !could_aspire) {
+                return;
+            }
+
+            int violations = insert ? move_evaluator.insertViolationCount(i, j) : move_evaluator.swapViolationCount(i, j);
+            bool aspires = violations == 0 && could_aspire;
+            if (tabu && !aspires) {
+                return;
+            }
+
+            Move move{violations, delta, i, j};
+            if (!(move < best)) {
+                return;
+            }
+
+            auto next_hash = insert ? this->hashInsert(hash, schedule, i, j) : this->hashSwap(hash, schedule, i, j);
+            if (!aspires && this->wasVisited(next_hash)) {
+                Stats::add(Stats::tabu_revisits);
+                return;
+            }
+
+            best = move;
+        };
+
+        for (int i = 0; i < job_count; i++) {
+            move_evaluator.swapTimespanDeltas(i, this->deltas);
+            for (int j = i + 1; j < job_count; j++) {
+                consider(i, j, this->deltas[j], false, best_swap);
+            }
+
+            move_evaluator.insertTimespanDeltas(i, this->deltas);
+            for (int j = 0; j < job_count; j++) {
+                if (j != i) {
+                    consider(i, j, this->deltas[j], true, best_insert);
+                }
+            }
+        }
+        moves_evaluated += static_cast<long long>(job_count) * (job_count - 1) * 3 / 2;
+
+        // every move is tabu or leads back to a recent schedule
+        if (!best_swap.found() && !best_insert.found()) {
+            break;
+        }
+
+        bool insert = std::tie(best_insert.violations, best_insert.timespan_delta) < std::tie(best_swap.violations, best_swap.timespan_delta);
+        const auto& move = insert ? best_insert : best_swap;
+        if (insert) {
+            hash = this->hashInsert(hash, schedule, move.row, move.column);
+            this->makeTabu(schedule[move.row], move.row, tenure_distribution(generator));
+            move_evaluator.applyInsert(move.row, move.column);
+        } else {
+            hash = this->hashSwap(hash, schedule, move.row, move.column);
+            this->makeTabu(schedule[move.row], move.row, tenure_distribution(generator));
+            this->makeTabu(schedule[move.column], move.column, tenure_distribution(generator));
+            move_evaluator.applySwap(move.row, move.column);
+        }
+        this->markVisited(hash);
+
+        int violations = move_evaluator.getViolationCount();
+        int timespan = move_evaluator.getTimespan();
+        if (violations < best_violations || (violations == best_violations && timespan < best_timespan)) {
+            this->best_schedule = schedule;
+            best_violations = violations;
+            best_timespan = timespan;
+        }
+    }
+
+    if (this->best_schedule != schedule) {
+        move_evaluator.load(this->best_schedule);
+    }
+}
+
+bool TabuSearch::isTabu(int id, int position) const {
+    return this->tabu_until[(id - 1) * this->position_slots + position / this->position_stride] > this->iteration;
+}
+
+void TabuSearch::makeTabu(int id, int position, int tenure) {
+    this->tabu_until[(id - 1) * this->position_slots + position / this->position_stride] = this->iteration + tenure;
+}
+
+// a key per job and position, mixed out of the pair (splitmix64's finalizer) rather than drawn into a
+// job_count * job_count table, so the hash costs no memory
+std::uint64_t TabuSearch::key(int id, int position) {
+    std::uint64_t value = (static_cast<std::uint64_t>(id) << 32 | static_cast<std::uint32_t>(position)) + 0x9e3779b97f4a7c15;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+
+    return value ^ (value >> 31);
+}
+
+std::uint64_t TabuSearch::hashSwap(std::uint64_t hash, const std::vector<int>& schedule, int first_position, int second_position) const {
+    int first = schedule[first_position];
+    int second = schedule[second_position];
+
+    return hash ^ key(first, first_position) ^ key(second, second_position) ^ key(first, second_position) ^ key(second, first_position);
+}
+
+// the jobs between the two positions shift by one, so this one is O(distance)
+std::uint64_t TabuSearch::hashInsert(std::uint64_t hash, const std::vector<int>& schedule, int from_position, int to_position) const {
+    int moved = schedule[from_position];
+    hash ^= key(moved, from_position) ^ key(moved, to_position);
+
+    if (to_position > from_position) {
+        for (int k = from_position + 1; k <= to_position; k++) {
+            hash ^= key(schedule[k], k) ^ key(schedule[k], k - 1);
+        }
+    } else {
+        for (int k = to_position; k < from_position; k++) {
+            hash ^= key(schedule[k], k) ^ key(schedule[k], k + 1);
+        }
+    }
+
+    return hash;
+}
+
+bool TabuSearch::wasVisited(std::uint64_t hash) const {
+    return this->visited[hash & (visited_slots - 1)] == hash;
+}
+
+void TabuSearch::markVisited(std::uint64_t hash) {
+    this->visited[hash & (visited_slots - 1)] = hash;
+}
@@ -0,0 +1,110 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+ThreadPool::ThreadPool(int thread_count): running_tasks{0}, stopping{false} {
+    if (thread_count < 1) {
+        throw std::invalid_argument{"Thread pool needs at least one thread.\n"};
+    }
+
+    this->workers.reserve(thread_count);
+    for (int i = 0; i < thread_count; i++) {
+        this->workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{this->tasks_mutex};
+        this->stopping = true;
+    }
+    this->task_available.notify_all();
+
+    for (auto& worker : this->workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::getThreadCount() const {
+    return this->workers.size();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard lock{this->tasks_mutex};
+        this->tasks.push_back(std::move(task));
+    }
+    this->task_available.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock{this->tasks_mutex};
+    this->tasks_finished.wait(lock, [this]() {
+        return this->tasks.empty() && this->running_tasks == 0;
+    });
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& task) {
+    // shared with the helpers, one may only get to run after the call returned and find nothing left
+    struct Batch {
+        std::atomic<int> next_index{0};
+        std::atomic<int> finished{0};
+        int count;
+        const std::function<void(int)>* task;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->count = count;
+    batch->task = &task;
+
+    auto run = [batch]() {
+        for (int index = batch->next_index.fetch_add(1); index < batch->count; index = batch->next_index.fetch_add(1)) {
+            (*batch->task)(index);
+
+            if (batch->finished.fetch_add(1) + 1 == batch->count) {
+                batch->finished.notify_all();
+            }
+        }
+    };
+
+    int helper_count = std::min(count - 1, this->getThreadCount());
+    for (int i = 0; i < helper_count; i++) {
+        this->submit(run);
+    }
+    run();
+
+    for (int finished = batch->finished.load(); finished < count; finished = batch->finished.load()) {
+        batch->finished.wait(finished);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock lock{this->tasks_mutex};
+            this->task_available.wait(lock, [this]() {
+                return this->stopping || !this->tasks.empty();
+            });
+
+            if (this->tasks.empty()) {  // only reached when stopping
+                return;
+            }
+
+            task = std::move(this->tasks.front());
+            this->tasks.pop_front();
+            this->running_tasks++;
+        }
+
+        task();
+
+        {
+            std::lock_guard lock{this->tasks_mutex};
+            this->running_tasks--;
+        }
+        this->tasks_finished.notify_all();
+    }
+}
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "candidate_lists.hpp"
+#include "dependency_graph.hpp"
+#include "greedy.hpp"
+#include "instance_generator.hpp"
+#include "local_search.hpp"
+#include "move_evaluator.hpp"
+#include "schedule_evaluator.hpp"
+#include "sized_kernels.hpp"
+#include "stats.hpp"
+#include "tabu_search.hpp"
+
+// the skip code ctest is told about in CMakeLists.txt
+constexpr int skipped = 77;
+
+long long allocationCount() {
+    return Stats::collect().counters[Stats::allocations];
+}
+
+// The per-iteration work of a solver worker on the workspace it keeps across iterations: loading a
+// start, the descent over the full and the granular neighborhoods, the tabu search and the whole
+// schedule evaluations. Once one round has sized everything, no further round may touch the heap.
+int main() {
+    if (!Stats::enabled) {
+        std::cout << "built without SCHEDULING_STATS, allocations can't be counted\n";
+
+        return skipped;
+    }
+
+    // the counter has to see an allocation, or nothing below could fail
+    long long before_probe = allocationCount();
+    auto* probe = new std::vector<int>(16);
+    delete probe;
+    if (allocationCount() == before_probe) {
+        std::cout << "the allocation counter missed an allocation\n";
+
+        return 1;
+    }
+
+    int failures = 0;
+    for (int job_count : {10, 50, 100, 300}) {
+        InstanceGenerator::Options generator_options;
+        generator_options.job_count = job_count;
+        auto dependency_graph = DependencyGraph::fromText(InstanceGenerator::generate(generator_options), InstanceGenerator::fileName(generator_options));
+
+        std::vector<std::vector<int>> schedules;
+        for (unsigned int seed = 1; seed <= 6; seed++) {
+            schedules.push_back(Greedy::greedyRandomizedAdaptiveProcedure(dependency_graph, 0.3, seed));
+        }
+
+        MoveEvaluator move_evaluator{dependency_graph};
+        ScheduleEvaluator schedule_evaluator{dependency_graph};
+        auto kernels = SizedKernels::make(dependency_graph);
+        CandidateLists candidate_lists{dependency_graph, 8};
+        auto neighborhoods = LocalSearch::defaultNeighborhoods();
+        auto granular_neighborhoods = LocalSearch::granularNeighborhoods(candidate_lists);
+        TabuSearch tabu_search{job_count};
+        std::mt19937 generator{1};
+        long long moves_evaluated = 0;
+
+        auto search = [&](const std::vector<int>& schedule) {
+            move_evaluator.load(schedule);
+            LocalSearch::descend(move_evaluator, neighborhoods, moves_evaluated);
+            tabu_search.run(move_evaluator, 10, std::chrono::steady_clock::time_point::max(), generator, moves_evaluated);
+            schedule_evaluator.evaluate(move_evaluator.getSchedule());
+            kernels->evaluate(move_evaluator.getSchedule());
+
+            move_evaluator.load(schedule);
+            LocalSearch::descend(move_evaluator, granular_neighborhoods, moves_evaluated);
+            schedule_evaluator.evaluate(move_evaluator.getSchedule());
+        };
+
+        search(schedules[0]);
+
+        long long allocations_before = allocationCount();
+        for (int i = 1; i < schedules.size(); i++) {
+            search(schedules[i]);
+        }
+        long long allocations = allocationCount() - allocations_before;
+
+        std::cout << job_count << " jobs: " << allocations << " allocations over " << schedules.size() - 1 << " warm searches\n";
+        if (allocations != 0) {
+            failures++;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "dependency_graph.hpp"
+#include "exact_solver.hpp"
+#include "instance_generator.hpp"
+#include "schedule_evaluator.hpp"
+
+// the shortest valid timespan over every permutation, or nothing valid at all
+int bruteForceTimespan(const DependencyGraph& dependency_graph) {
+    ScheduleEvaluator schedule_evaluator{dependency_graph};
+
+    std::vector<int> schedule(dependency_graph.getJobCount());
+    std::iota(schedule.begin(), schedule.end(), 1);
+
+    int best_timespan = std::numeric_limits<int>::max();
+    do {
+        auto evaluation = schedule_evaluator.evaluate(schedule);
+        if (evaluation.valid) {
+            best_timespan = std::min(best_timespan, evaluation.timespan);
+        }
+    } while (std::next_permutation(schedule.begin(), schedule.end()));
+
+    return best_timespan;
+}
+
+// The exact solver against brute force on random small instances, with short jobs and setups next
+// to long delays so several arcs are open at once and the dominance check has something to compare;
+// a wrong prune shows up as a longer timespan still claimed optimal.
+int main(int argc, char *argv[]) {
+    int instance_count = argc > 1 ? std::stoi(argv[1]) : 1000;
+
+    std::mt19937 generator{2024};
+    int mismatches = 0;
+    for (int instance = 1; instance <= instance_count; instance++) {
+        InstanceGenerator::Options generator_options;
+        generator_options.job_count = std::uniform_int_distribution<>{5, 8}(generator);
+        generator_options.processing_time = {1, 10};
+        generator_options.setup_time = {0, 10};
+        generator_options.delay = {1, 30};
+        generator_options.arc_count = std::uniform_int_distribution<>{2, generator_options.job_count - 1}(generator);
+        generator_options.zero_delay_arc_count = 0;
+        generator_options.instance_number = instance;
+        generator_options.seed = generator();
+
+        auto dependency_graph = DependencyGraph::fromText(InstanceGenerator::generate(generator_options), InstanceGenerator::fileName(generator_options));
+        int expected_timespan = bruteForceTimespan(dependency_graph);
+
+        for (int threads : {1, 2}) {
+            ExactSolver::Options solver_options;
+            solver_options.threads = threads;
+            auto result = ExactSolver::solve(dependency_graph, solver_options);
+
+            bool expected_valid = expected_timespan != std::numeric_limits<int>::max();
+            if (!result.optimal || result.valid != expected_valid || (expected_valid && result.timespan != expected_timespan)) {
+                mismatches++;
+                std::cout << InstanceGenerator::fileName(generator_options) << " (seed " << generator_options.seed << ", "
+                          << threads << " threads): expected " << (expected_valid ? std::to_string(expected_timespan) : "no valid schedule")
+                          << ", got " << (result.valid ? std::to_string(result.timespan) : "no valid schedule")
+                          << (result.optimal ? " (optimal)" : "") << "\n";
+            }
+        }
+    }
+
+    std::cout << mismatches << " mismatches in " << instance_count << " instances\n";
+
+    return mismatches == 0 ? 0 : 1;
+}